@@ -0,0 +1,50 @@
+# Measures the number of states per second that TOOL (lps2lts) explores on INPUT
+# for every number of threads in THREADS, which is a comma separated list.
+#
+# Usage: cmake -DTOOL=<lps2lts> -DINPUT=<file.lps> -DTHREADS=1,2,4 [-DARGUMENTS=...] -P statespace_scaling.cmake
+
+if(NOT TOOL OR NOT INPUT OR NOT THREADS)
+  message(FATAL_ERROR "The variables TOOL, INPUT and THREADS must be set.")
+endif()
+
+string(REPLACE "," ";" THREAD_COUNTS "${THREADS}")
+separate_arguments(EXTRA_ARGUMENTS UNIX_COMMAND "${ARGUMENTS}")
+
+# Microseconds are only supported by string(TIMESTAMP) since CMake 3.23.
+if(CMAKE_VERSION VERSION_LESS 3.23)
+  set(TIMESTAMP_FORMAT "%s")
+  set(TIMESTAMP_SCALE 1)
+else()
+  set(TIMESTAMP_FORMAT "%s%f")
+  set(TIMESTAMP_SCALE 1000000)
+endif()
+
+get_filename_component(NAME ${INPUT} NAME_WE)
+
+foreach(N ${THREAD_COUNTS})
+  string(TIMESTAMP START "${TIMESTAMP_FORMAT}" UTC)
+  execute_process(
+    COMMAND ${TOOL} --verbose --threads=${N} ${EXTRA_ARGUMENTS} ${INPUT}
+    RESULT_VARIABLE RESULT
+    ERROR_VARIABLE OUTPUT
+    OUTPUT_QUIET)
+  string(TIMESTAMP FINISH "${TIMESTAMP_FORMAT}" UTC)
+
+  if(NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "${TOOL} --threads=${N} failed on ${INPUT}:\n${OUTPUT}")
+  endif()
+
+  if(NOT OUTPUT MATCHES "done with state space generation \\(([^)]*, )?([0-9]+) states?")
+    message(FATAL_ERROR "Could not determine the number of states from the output of ${TOOL}:\n${OUTPUT}")
+  endif()
+  set(STATES ${CMAKE_MATCH_2})
+
+  # Compute the time in milliseconds, and avoid a division by zero for very small state spaces.
+  math(EXPR MILLISECONDS "(${FINISH} - ${START}) * 1000 / ${TIMESTAMP_SCALE}")
+  if(MILLISECONDS EQUAL 0)
+    set(MILLISECONDS 1)
+  endif()
+  math(EXPR STATES_PER_SECOND "${STATES} * 1000 / ${MILLISECONDS}")
+
+  message(STATUS "${NAME}: threads=${N} states=${STATES} time=${MILLISECONDS}ms states/second=${STATES_PER_SECOND}")
+endforeach()
@@ -11,13 +11,29 @@
 #define MCRL2_ATERMPP_ATERM_IO_BINARY_H
 
 #include "mcrl2/atermpp/aterm_io.h"
+#include "mcrl2/atermpp/standard_containers/indexed_set.h"
 
 #include "mcrl2/utilities/bitstream.h"
 #include "mcrl2/utilities/indexed_set.h"
 
+#include <memory>
+#include <mutex>
+#include <sstream>
+
 namespace atermpp
 {
 
+namespace detail
+{
+  class chunked_aterm_reader;
+
+  template <typename Writer>
+  void write_term(Writer& writer, const aterm& term);
+
+  template <typename Reader>
+  aterm read_term(Reader& reader);
+} // namespace detail
+
 /// \brief Writes terms in a streamable binary aterm format to an output stream.
 /// \details The streamable aterm format:
 ///
@@ -34,7 +50,8 @@ class binary_aterm_ostream final : public aterm_ostream
 {
 public:
   /// \brief Provide the output stream to which the terms are written.
-  binary_aterm_ostream(std::ostream& os);
+  /// \param compress If true, the stream is block compressed, see mcrl2::utilities::obitstream.
+  binary_aterm_ostream(std::ostream& os, bool compress = mcrl2::utilities::default_stream_compression());
   binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obitstream> stream);
 
   ~binary_aterm_ostream() override;
@@ -44,6 +61,9 @@ public:
   void put(const aterm &term) override;
 
 private:
+  template <typename Writer>
+  friend void detail::write_term(Writer& writer, const aterm& term);
+
   /// \brief Write a function symbol to the output stream.
   std::size_t write_function_symbol(const function_symbol& symbol);
 
@@ -62,7 +82,99 @@ private:
   mcrl2::utilities::indexed_set<function_symbol> m_function_symbols; ///< An index of already written function symbols.
 };
 
-/// \brief Reads terms from a stream in the steamable binary aterm format.
+/// \brief A sequence of terms in the chunked binary aterm format, that is encoded independently of other chunks.
+/// \details A chunk has its own index of terms and function symbols. Chunks can therefore be filled
+///          concurrently, for instance one per thread, after which they are appended to a
+///          chunked_binary_aterm_ostream. A chunk must be destroyed by the thread that filled it.
+class binary_aterm_chunk final : public aterm_ostream
+{
+public:
+  binary_aterm_chunk();
+
+  /// \brief Adds the term to this chunk, sharing its subterms with the terms that were added before.
+  void put(const aterm& term) override;
+
+  /// \returns The number of terms that were put in this chunk.
+  std::size_t number_of_terms() const { return m_number_of_terms; }
+
+  /// \returns The (approximate) number of bytes needed to store the terms of this chunk.
+  std::size_t size() { return static_cast<std::size_t>(m_buffer.tellp()); }
+
+private:
+  friend class chunked_binary_aterm_ostream;
+
+  template <typename Writer>
+  friend void detail::write_term(Writer& writer, const aterm& term);
+
+  /// \brief Removes all terms from this chunk.
+  void clear();
+
+  /// \brief Writes a function symbol packet and returns the index of the symbol in this chunk.
+  std::size_t write_function_symbol(const function_symbol& symbol);
+
+  unsigned int term_index_width();
+  unsigned int function_symbol_index_width();
+
+  std::ostringstream m_buffer; ///< The encoded terms.
+  std::shared_ptr<mcrl2::utilities::obitstream> m_stream; ///< A bit stream that writes to m_buffer.
+  std::size_t m_number_of_terms = 0;
+
+  unsigned int m_term_index_width;
+  unsigned int m_function_symbol_index_width;
+
+  atermpp::indexed_set<aterm> m_terms; ///< An index of the terms in this chunk, protected as a whole such that any thread can clear it.
+  mcrl2::utilities::indexed_set<function_symbol> m_function_symbols; ///< An index of the function symbols in this chunk.
+};
+
+/// \brief Writes terms in the chunked binary aterm format to an output stream.
+/// \details The chunked binary aterm format:
+///
+///          The stream starts with the same header as the streamable format, but with a different version.
+///          The terms are stored in a sequence of chunks. Each chunk is encoded as in the streamable
+///          format, but with its own index of terms. The function symbols are stored once in a table that
+///          is shared by all chunks; a chunk only contains the indices in this table of the function symbols
+///          that it uses. Every chunk starts with its number of terms, the function symbols that are added to
+///          the table, the indices of its function symbols and the size of the encoded terms in bytes. This
+///          allows a reader to locate the chunks without decoding them and to decode them in parallel. A chunk
+///          without terms indicates the end of the stream.
+///
+///          Terms are collected in a chunk that is written when it exceeds the given chunk size (in bytes),
+///          or when the transformer changes. Other chunks can be appended concurrently using append.
+class chunked_binary_aterm_ostream final : public aterm_ostream
+{
+public:
+  /// \brief The default number of bytes of a chunk.
+  static constexpr std::size_t default_chunk_size = 1 << 22;
+
+  /// \brief Provide the output stream to which the terms are written.
+  /// \param compress If true, the stream is block compressed, see mcrl2::utilities::obitstream.
+  chunked_binary_aterm_ostream(std::ostream& os, std::size_t chunk_size = default_chunk_size,
+                               bool compress = mcrl2::utilities::default_stream_compression());
+  chunked_binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obitstream> stream, std::size_t chunk_size = default_chunk_size);
+
+  ~chunked_binary_aterm_ostream() override;
+
+  /// \brief Writes an aterm. Subterms are only shared with the other terms in the same chunk.
+  void put(const aterm& term) override;
+
+  /// \brief Writes the terms of the given chunk to the stream, after which the chunk is empty.
+  /// \details The terms that were put in this stream before are written first.
+  /// \threadsafe
+  void append(binary_aterm_chunk& chunk);
+
+private:
+  /// \brief Writes the given chunk to the stream, where m_mutex must be locked.
+  void write_chunk(binary_aterm_chunk& chunk);
+
+  std::shared_ptr<mcrl2::utilities::obitstream> m_stream;
+  std::size_t m_chunk_size;
+  binary_aterm_chunk m_chunk; ///< The chunk in which put stores the terms.
+  mcrl2::utilities::indexed_set<function_symbol> m_function_symbols; ///< The table of function symbols of all chunks.
+  std::mutex m_mutex;
+};
+
+/// \brief Reads terms from a stream in the steamable binary aterm format, or in the chunked binary aterm format.
+/// \details The chunks of the chunked format are decoded in parallel if the term library is thread safe.
 class binary_aterm_istream final : public aterm_istream
 {
 public:
@@ -70,9 +182,17 @@ public:
   binary_aterm_istream(std::istream& is);
   binary_aterm_istream(std::shared_ptr<mcrl2::utilities::ibitstream> stream);
 
+  ~binary_aterm_istream() override;
+
   aterm get() override;
 
 private:
+  template <typename Reader>
+  friend aterm detail::read_term(Reader& reader);
+
+  /// \brief Reads a function symbol from the input stream.
+  void read_function_symbol();
+
   /// \returns The number of bits needed to index terms.
   unsigned int term_index_width();
 
@@ -86,6 +206,8 @@ private:
 
   std::deque<aterm> m_terms; ///< An index of read terms.
   std::deque<function_symbol> m_function_symbols; ///< An index of read function symbols.
+
+  std::unique_ptr<detail::chunked_aterm_reader> m_chunks; ///< Reads the chunks of the chunked format.
 };
 
 } // namespace atermpp
@@ -12,6 +12,8 @@
 
 #include "mcrl2/utilities/configuration.h"
 
+#include <cstddef>
+
 namespace atermpp
 {
 namespace detail
@@ -39,6 +41,18 @@ constexpr static bool EnableHashtableMetrics = false;
 /// \brief Enable to obtain the percentage of terms found compared to allocated.
 constexpr static bool EnableCreationMetrics = false;
 
+/// \brief The maximum number of terms that a thread creates before the global counters that
+///        trigger garbage collection and resizing are updated.
+constexpr static long MaximumTermCreationBudget = 1024;
+
+/// \brief The minimum number of terms in the pool for which garbage collection uses multiple threads.
+constexpr static std::size_t ParallelGarbageCollectionThreshold = 1 << 20;
+
+/// \brief The number of buckets of a term hash table that are split each time the pool is resized.
+/// \details The hash tables grow incrementally, such that the other threads are only stopped for a short
+///          time. This step must exceed the number of terms created in between two resizes.
+constexpr static std::size_t IncrementalRehashStep = 1 << 14;
+
 /// \brief Keep track of the number of variables registered.
 constexpr static bool EnableVariableRegistrationMetrics = false;
 
@@ -0,0 +1,129 @@
+// Author(s): Maurice Laveaux.
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_ATERMPP_DETAIL_ATERM_HEAP_PROFILE_H
+#define MCRL2_ATERMPP_DETAIL_ATERM_HEAP_PROFILE_H
+
+#include "mcrl2/atermpp/detail/function_symbol_hash.h"
+
+#include <algorithm>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace atermpp
+{
+namespace detail
+{
+
+/// \brief The number of terms with a certain function symbol, and the number of bytes that they occupy.
+struct heap_profile_entry
+{
+  std::size_t live_terms = 0;
+  std::size_t live_bytes = 0;
+  std::size_t freed_terms = 0;
+  std::size_t freed_bytes = 0;
+};
+
+/// \brief Counts the terms that survived and the terms that were freed by a garbage collection per function symbol.
+/// \details The bytes are those of the term objects themselves, which excludes the hash tables of the term pool.
+class heap_profile
+{
+public:
+  /// \brief Counts a term with the given function symbol of the given size that is still reachable.
+  void add_live(const function_symbol& symbol, std::size_t bytes)
+  {
+    heap_profile_entry& entry = m_entries[symbol];
+    ++entry.live_terms;
+    entry.live_bytes += bytes;
+  }
+
+  /// \brief Counts a term with the given function symbol of the given size that has been freed.
+  void add_freed(const function_symbol& symbol, std::size_t bytes)
+  {
+    heap_profile_entry& entry = m_entries[symbol];
+    ++entry.freed_terms;
+    entry.freed_bytes += bytes;
+  }
+
+  /// \brief Adds the counts of the other profile to this profile.
+  void merge(const heap_profile& other)
+  {
+    for (const auto& [symbol, other_entry] : other.m_entries)
+    {
+      heap_profile_entry& entry = m_entries[symbol];
+      entry.live_terms += other_entry.live_terms;
+      entry.live_bytes += other_entry.live_bytes;
+      entry.freed_terms += other_entry.freed_terms;
+      entry.freed_bytes += other_entry.freed_bytes;
+    }
+  }
+
+  void clear()
+  {
+    m_entries.clear();
+  }
+
+  /// \brief Writes the profile in a YAML compatible format, where the function symbols with the most live bytes come first.
+  /// \param collection The number of the garbage collection after which the profile was made.
+  void write(std::ostream& os, std::size_t collection) const
+  {
+    std::vector<std::pair<function_symbol, heap_profile_entry>> entries(m_entries.begin(), m_entries.end());
+    std::sort(entries.begin(), entries.end(), [](const auto& x, const auto& y)
+      {
+        return x.second.live_bytes > y.second.live_bytes
+               || (x.second.live_bytes == y.second.live_bytes && x.second.freed_bytes > y.second.freed_bytes);
+      });
+
+    heap_profile_entry total;
+    for (const auto& [symbol, entry] : entries)
+    {
+      total.live_terms += entry.live_terms;
+      total.live_bytes += entry.live_bytes;
+      total.freed_terms += entry.freed_terms;
+      total.freed_bytes += entry.freed_bytes;
+    }
+
+    os << "- collection: " << collection << "\n";
+    write_entry(os, "  ", total);
+    os << "  function_symbols:\n";
+    for (const auto& [symbol, entry] : entries)
+    {
+      os << "    - name: \"";
+      for (char c : symbol.name())
+      {
+        if (c == '"' || c == '\\')
+        {
+          os << '\\';
+        }
+        os << c;
+      }
+      os << "\"\n";
+      os << "      arity: " << symbol.arity() << "\n";
+      write_entry(os, "      ", entry);
+    }
+    os.flush();
+  }
+
+private:
+  static void write_entry(std::ostream& os, const char* indentation, const heap_profile_entry& entry)
+  {
+    os << indentation << "live_terms: " << entry.live_terms << "\n"
+       << indentation << "live_bytes: " << entry.live_bytes << "\n"
+       << indentation << "freed_terms: " << entry.freed_terms << "\n"
+       << indentation << "freed_bytes: " << entry.freed_bytes << "\n";
+  }
+
+  std::unordered_map<function_symbol, heap_profile_entry> m_entries;
+};
+
+} // namespace detail
+} // namespace atermpp
+
+#endif // MCRL2_ATERMPP_DETAIL_ATERM_HEAP_PROFILE_H
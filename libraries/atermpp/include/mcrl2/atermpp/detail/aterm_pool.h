@@ -13,6 +13,10 @@
 #include "mcrl2/atermpp/detail/aterm_pool_storage.h"
 #include "mcrl2/atermpp/detail/function_symbol_pool.h"
 
+#include <array>
+#include <chrono>
+#include <string>
+
 namespace atermpp
 {
 namespace detail
@@ -96,6 +100,19 @@ public:
   /// \brief Prints various performance statistics for the term pool.
   inline void print_performance_statistics() const;
 
+  /// \brief Appends a heap profile to the given file after every garbage collection.
+  /// \details The heap profile contains the number of terms, and the number of bytes that they occupy, that
+  ///          survived and that were freed by the garbage collection per function symbol. It is written in a YAML
+  ///          compatible format. Counting the terms makes the sweep phase slightly slower. The heap profile is
+  ///          also enabled when the environment variable MCRL2_ATERM_HEAP_PROFILE contains a filename.
+  /// \param filename The file to which the profiles are appended, or the empty string to disable profiling.
+  inline void enable_heap_profile(const std::string& filename);
+
+  /// \brief Performs a garbage collection and writes its heap profile to the given stream.
+  /// \details Nothing is written when garbage collection is disabled.
+  /// \threadsafe
+  inline void write_heap_profile(std::ostream& os);
+
   /// \returns A global term that indicates the empty list.
   aterm& empty_list() noexcept { return m_empty_list; }
 
@@ -119,15 +136,22 @@ public:
   // These functions of the aterm pool should be called through a thread_aterm_pool.
 private:
 
-  /// \brief Triggers garbage collection and resizing when conditions are met.
+  /// \brief Triggers garbage collection and resizing when conditions are met, and reserves the
+  ///        number of terms that the calling thread can create before it must call this function again.
+  /// \details The counters that determine when garbage collection and resizing take place are shared by
+  ///          all threads. To avoid that every term creation updates them, each thread obtains a budget that
+  ///          it consumes locally, and only calls this function when the budget is exhausted.
   /// \param allow_collect Actually perform the garbage collection instead of only updating the counters.
   /// \param thread The pool that called this function.
+  /// \returns The number of terms that the thread can create.
   /// \threadsafe
-  inline void created_term(bool allow_collect, thread_aterm_pool_interface* thread);
+  inline long reserve_creation_budget(bool allow_collect, thread_aterm_pool_interface* thread);
 
   /// \brief Collect garbage on all storages.
+  /// \param profile_stream If not nullptr, the collection takes place even if another thread has just
+  ///        collected garbage, and the heap profile of this collection is written to this stream.
   /// \threadsafe
-  inline void collect_impl(thread_aterm_pool_interface* thread);
+  inline void collect_impl(thread_aterm_pool_interface* thread, std::ostream* profile_stream = nullptr);
 
   /// \brief Creates a integral term with the given value.
   inline bool create_int(aterm& term, std::size_t val);
@@ -158,6 +182,16 @@ private:
       InputIterator begin,
       InputIterator end);
 
+  /// \brief Applies f(i) to every i in [0, n). When parallel is true the calls are
+  ///        divided dynamically over a number of threads.
+  template<typename Function>
+  inline void parallel_for(std::size_t n, bool parallel, Function f);
+
+  /// \brief Applies f to the storage with the given index, where 0 is the integral storage,
+  ///        1 up to 8 are the storages for arities 0 up to 7 and 9 is the dynamic storage.
+  template<typename Function>
+  inline void apply_to_storage(std::size_t index, Function f);
+
   /// \brief Resizes all storages if necessary.
   /// \threadsafe.
   inline void resize_if_needed(thread_aterm_pool_interface* thread);
@@ -202,6 +236,21 @@ private:
   std::atomic<long> m_count_until_collection = 0;
   std::atomic<long> m_count_until_resize = 0;
 
+  /// Statistics on the number of garbage collections and the time that all threads were stopped.
+  std::size_t m_number_of_collections = 0;
+  std::size_t m_number_of_parallel_collections = 0;
+  std::chrono::milliseconds::rep m_total_pause_time = 0;
+  std::chrono::milliseconds::rep m_maximum_pause_time = 0;
+
+  /// The number of times that a thread has reserved a budget to create terms.
+  std::atomic<std::size_t> m_budget_reservations = 0;
+
+  /// The file to which a heap profile is appended after every garbage collection, if it is not empty.
+  std::string m_heap_profile_filename;
+
+  /// The heap profiles of the individual storages, which are merged after a garbage collection.
+  std::array<heap_profile, 10> m_heap_profiles;
+
   std::atomic<bool> m_enable_garbage_collection = EnableGarbageCollection; /// Garbage collection is enabled.
 
   /// Represents an empty list.
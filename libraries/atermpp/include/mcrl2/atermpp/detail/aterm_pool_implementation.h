@@ -11,7 +11,13 @@
 #define ATERMPP_DETAIL_ATERM_POOL_IMPLEMENTATION_H
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <thread>
 #include "aterm_pool.h"
 #include "aterm_pool_storage_implementation.h"   // For store_in_argument_array. 
 
@@ -37,6 +43,11 @@ aterm_pool::aterm_pool() :
 {
   m_count_until_collection = capacity();
   m_count_until_resize = m_int_storage.capacity();
+
+  if (const char* filename = std::getenv("MCRL2_ATERM_HEAP_PROFILE"))
+  {
+    enable_heap_profile(filename);
+  }
   
   // Initialize the empty list.
   create_appl(m_empty_list, m_function_symbol_pool.as_empty_list());
@@ -135,6 +146,14 @@ void aterm_pool::print_performance_statistics() const
 
   m_appl_dynamic_storage.print_performance_stats("arbitrary_function_application_storage");
 
+  if (EnableGarbageCollectionMetrics)
+  {
+    mCRL2log(mcrl2::log::info, "Performance") << "aterm_pool: " << m_number_of_collections << " garbage collections (" << m_number_of_parallel_collections
+                                              << " using multiple threads) paused all threads for " << m_total_pause_time << " ms in total and "
+                                              << m_maximum_pause_time << " ms at most.\n";
+    mCRL2log(mcrl2::log::info, "Performance") << "aterm_pool: threads reserved a budget for creating terms " << m_budget_reservations.load() << " times.\n";
+  }
+
 #ifdef MCRL2_ATERMPP_REFERENCE_COUNTED
   if (mcrl2::utilities::EnableReferenceCountMetrics)
   {
@@ -148,6 +167,18 @@ void aterm_pool::print_performance_statistics() const
   }
 }
 
+void aterm_pool::enable_heap_profile(const std::string& filename)
+{
+  if constexpr (GlobalThreadSafe) { m_mutex.lock(); }
+  m_heap_profile_filename = filename;
+  if constexpr (GlobalThreadSafe) { m_mutex.unlock(); }
+}
+
+void aterm_pool::write_heap_profile(std::ostream& os)
+{
+  collect_impl(nullptr, &os);
+}
+
 std::size_t aterm_pool::capacity() const noexcept
 {
   // Determine the total number of terms in any storage.
@@ -180,7 +211,7 @@ std::size_t aterm_pool::size() const
 
 // private
 
-void aterm_pool::created_term(bool allow_collect, thread_aterm_pool_interface* thread)
+long aterm_pool::reserve_creation_budget(bool allow_collect, thread_aterm_pool_interface* thread)
 {
   // Defer garbage collection when it happens too often.
   if (m_count_until_collection.load(std::memory_order_relaxed) <= 0)
@@ -190,10 +221,6 @@ void aterm_pool::created_term(bool allow_collect, thread_aterm_pool_interface* t
       collect_impl(thread);
     }
   }
-  else
-  {
-    m_count_until_collection.fetch_sub(1, std::memory_order_relaxed);
-  }
 
   if (m_count_until_resize.load(std::memory_order_relaxed) <= 0)
   {
@@ -202,26 +229,45 @@ void aterm_pool::created_term(bool allow_collect, thread_aterm_pool_interface* t
       resize_if_needed(thread);
     }
   }
-  else
+
+  // Give out a fraction of the remaining terms, such that the other threads can still reserve
+  // a budget, and the counters do not end far below zero. If a collection or resize is pending
+  // the budget is one, such that the thread tries again after creating the next term.
+  long remaining = m_count_until_resize.load(std::memory_order_relaxed);
+  if (m_enable_garbage_collection)
   {
-    m_count_until_resize.fetch_sub(1, std::memory_order_relaxed);
+    remaining = std::min(remaining, m_count_until_collection.load(std::memory_order_relaxed));
   }
+  const long budget = std::clamp(remaining / 16, 1L, MaximumTermCreationBudget);
+
+  m_count_until_collection.fetch_sub(budget, std::memory_order_relaxed);
+  m_count_until_resize.fetch_sub(budget, std::memory_order_relaxed);
+  m_budget_reservations.fetch_add(1, std::memory_order_relaxed);
+  return budget;
 }
 
-void aterm_pool::collect_impl(thread_aterm_pool_interface* thread)
+void aterm_pool::collect_impl(thread_aterm_pool_interface* thread, std::ostream* profile_stream)
 {
   if (!m_enable_garbage_collection) { return; }
 
   lock(thread);
-  if (m_count_until_collection > 0)
+  if (m_count_until_collection > 0 && profile_stream == nullptr)
   {
     // Another thread has performed garbage collection, so we can ignore it.
     unlock();
     return;
   }
   auto timestamp = std::chrono::system_clock::now();
+  const auto pause_start = timestamp;
   std::size_t old_size = size();
 
+  // For large pools the root sets of the thread pools are marked, and the storages are swept,
+  // by multiple threads. The other threads are stopped during the collection.
+  const bool parallel = GlobalThreadSafe && old_size >= ParallelGarbageCollectionThreshold;
+
+  // Every storage counts its terms in its own profile, such that they can be swept in parallel.
+  const bool profile = profile_stream != nullptr || !m_heap_profile_filename.empty();
+
 #ifdef MCRL2_ATERMPP_REFERENCE_COUNTED
   // Marks all terms that are reachable via any reachable term to
   // not be garbage collected.
@@ -237,11 +283,13 @@ void aterm_pool::collect_impl(thread_aterm_pool_interface* thread)
   m_appl_dynamic_storage.mark();
 #endif // MCRL2_ATERMPP_REFERENCE_COUNTED
 
-  // Mark the terms referenced by all thread pools.
-  for (const auto& pool : m_thread_pools)
+  // Mark the terms referenced by all thread pools. Each thread pool uses its own todo
+  // stack. Terms that are reachable from several pools can be marked by several threads,
+  // which only sets the same mark bit multiple times.
+  parallel_for(m_thread_pools.size(), parallel, [this](std::size_t i)
   {
-    pool->mark();
-  }
+    m_thread_pools[i]->mark();
+  });
 
   assert(std::get<0>(m_appl_storage).verify_mark());
   assert(std::get<1>(m_appl_storage).verify_mark());
@@ -256,17 +304,42 @@ void aterm_pool::collect_impl(thread_aterm_pool_interface* thread)
   // Keep track of the duration for marking and reset for sweep.
   auto mark_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
   timestamp = std::chrono::system_clock::now();
+
   // Collect all terms that are not marked.
-  m_appl_dynamic_storage.sweep();
-  std::get<7>(m_appl_storage).sweep();
-  std::get<6>(m_appl_storage).sweep();
-  std::get<5>(m_appl_storage).sweep();
-  std::get<4>(m_appl_storage).sweep();
-  std::get<3>(m_appl_storage).sweep();
-  std::get<2>(m_appl_storage).sweep();
-  std::get<1>(m_appl_storage).sweep();
-  std::get<0>(m_appl_storage).sweep();
-  m_int_storage.sweep();
+  if (parallel)
+  {
+    // The deletion hooks can inspect the arguments of a term, so they are called before
+    // any term is destroyed. Afterwards the storages are swept independently.
+    for (std::size_t i = 10; i-- > 0; )
+    {
+      apply_to_storage(i, [](auto& storage) { storage.call_deletion_hooks(); });
+    }
+
+    // Start with the largest storages to balance the work over the threads.
+    std::array<std::size_t, 10> order;
+    std::array<std::size_t, 10> sizes;
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+      order[i] = i;
+      apply_to_storage(i, [&sizes, i](auto& storage) { sizes[i] = storage.size(); });
+    }
+    std::sort(order.begin(), order.end(), [&sizes](std::size_t i, std::size_t j) { return sizes[i] > sizes[j]; });
+
+    parallel_for(order.size(), true, [this, &order, profile](std::size_t i)
+    {
+      heap_profile* storage_profile = profile ? &m_heap_profiles[order[i]] : nullptr;
+      apply_to_storage(order[i], [storage_profile](auto& storage) { storage.sweep(false, storage_profile); });
+    });
+    ++m_number_of_parallel_collections;
+  }
+  else
+  {
+    for (std::size_t i = 10; i-- > 0; )
+    {
+      heap_profile* storage_profile = profile ? &m_heap_profiles[i] : nullptr;
+      apply_to_storage(i, [storage_profile](auto& storage) { storage.sweep(true, storage_profile); });
+    }
+  }
 
   // Check that after sweeping the terms are consistent.
   assert(m_int_storage.verify_sweep());
@@ -288,12 +361,46 @@ void aterm_pool::collect_impl(thread_aterm_pool_interface* thread)
 
     // Print the relevant information.
     mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): Garbage collected " << old_size - size() << " terms, " << size() << " terms remaining in "
-      << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms).\n";
+      << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms"
+      << (parallel ? " using multiple threads" : "") << ").\n";
+  }
+
+  ++m_number_of_collections;
+  if (profile)
+  {
+    // The profile refers to the function symbols of the freed terms, so it is written and
+    // cleared before the function symbols are collected.
+    for (std::size_t i = 1; i < m_heap_profiles.size(); ++i)
+    {
+      m_heap_profiles[0].merge(m_heap_profiles[i]);
+      m_heap_profiles[i].clear();
+    }
+
+    if (profile_stream != nullptr)
+    {
+      m_heap_profiles[0].write(*profile_stream, m_number_of_collections);
+    }
+
+    if (!m_heap_profile_filename.empty())
+    {
+      std::ofstream file(m_heap_profile_filename, std::ios::app);
+      m_heap_profiles[0].write(file, m_number_of_collections);
+      if (file.fail())
+      {
+        mCRL2log(mcrl2::log::warning) << "Could not write the heap profile to " << m_heap_profile_filename << ".\n";
+      }
+    }
+    m_heap_profiles[0].clear();
   }
 
   // Garbage collect function symbols.
   m_function_symbol_pool.sweep();
 
+  // Keep track of the time that the other threads were stopped.
+  auto pause_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - pause_start).count();
+  m_total_pause_time += pause_duration;
+  m_maximum_pause_time = std::max(m_maximum_pause_time, pause_duration);
+
   print_performance_statistics();
 
   // Use some heuristics to determine when the next collect should be called automatically.
@@ -399,6 +506,76 @@ bool aterm_pool::create_appl_dynamic(aterm& term,
   }
 }
 
+template<typename Function>
+void aterm_pool::parallel_for(std::size_t n, bool parallel, Function f)
+{
+  const std::size_t number_of_threads = parallel ? std::min<std::size_t>(n, std::thread::hardware_concurrency()) : 1;
+  if (number_of_threads <= 1)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      f(i);
+    }
+    return;
+  }
+
+  // The threads take the next index until all indices have been handled. These threads
+  // do not create terms, so they do not need a thread specific term pool.
+  std::atomic<std::size_t> next = 0;
+  std::vector<std::exception_ptr> exceptions(number_of_threads);
+  auto run = [&](std::size_t thread_index)
+  {
+    try
+    {
+      for (std::size_t i = next++; i < n; i = next++)
+      {
+        f(i);
+      }
+    }
+    catch (...)
+    {
+      exceptions[thread_index] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(run, i);
+  }
+  run(0);
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (const std::exception_ptr& exception : exceptions)
+  {
+    if (exception)
+    {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+template<typename Function>
+void aterm_pool::apply_to_storage(std::size_t index, Function f)
+{
+  switch (index)
+  {
+    case 0: f(m_int_storage); break;
+    case 1: f(std::get<0>(m_appl_storage)); break;
+    case 2: f(std::get<1>(m_appl_storage)); break;
+    case 3: f(std::get<2>(m_appl_storage)); break;
+    case 4: f(std::get<3>(m_appl_storage)); break;
+    case 5: f(std::get<4>(m_appl_storage)); break;
+    case 6: f(std::get<5>(m_appl_storage)); break;
+    case 7: f(std::get<6>(m_appl_storage)); break;
+    case 8: f(std::get<7>(m_appl_storage)); break;
+    default: f(m_appl_dynamic_storage);
+  }
+}
+
 void aterm_pool::resize_if_needed(thread_aterm_pool_interface* thread)
 {
   lock(thread);
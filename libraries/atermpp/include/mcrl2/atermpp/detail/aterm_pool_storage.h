@@ -11,6 +11,7 @@
 #define ATERMPP_DETAIL_ATERM_POOL_STORAGE_H
 
 #include "mcrl2/atermpp/detail/aterm_hash.h"
+#include "mcrl2/atermpp/detail/aterm_heap_profile.h"
 #include "mcrl2/utilities/cache_metric.h"
 #include "mcrl2/utilities/unordered_set.h"
 
@@ -151,11 +152,19 @@ public:
   void mark();
 #endif
 
+  /// \brief Calls the deletion hooks of all terms that are not reachable. Requires that
+  ///        mark() was called first.
+  void call_deletion_hooks();
+
   /// \brief sweep Destroys all terms that are not reachable. Requires that
   ///        mark() was called first.
-  void sweep();
+  /// \param call_hooks Call the deletion hooks of the destroyed terms. This should be false
+  ///        when call_deletion_hooks() has been called already.
+  /// \param profile If not nullptr, the remaining and destroyed terms are counted in this profile.
+  void sweep(bool call_hooks = true, heap_profile* profile = nullptr);
 
   /// \brief Resizes the hash table if necessary.
+  /// \details Only moves a bounded number of terms to their new bucket, see IncrementalRehashStep.
   void resize_if_needed();
 
   /// \returns The number of terms stored in this storage.
@@ -181,7 +190,7 @@ private:
   void call_deletion_hook(unprotected_aterm term);
 
   /// \brief Removes an element from the unordered set and deallocates it.
-  iterator destroy(iterator it);
+  iterator destroy(iterator it, bool call_hook);
 
   /// \brief Inserts a term constructed by the given arguments, checks for existing term.
   template<typename ...Args>
@@ -195,6 +204,9 @@ private:
   template<std::size_t Arity = N>
   bool verify_term(const _aterm& term);
 
+  /// \returns The number of bytes allocated for the given term.
+  static std::size_t term_size(const Element& term);
+
   /// The pool that this storage belongs to.
   aterm_pool& m_pool;
 
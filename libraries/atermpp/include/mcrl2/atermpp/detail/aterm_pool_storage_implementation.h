@@ -379,17 +379,46 @@ void ATERM_POOL_STORAGE::mark()
 #endif
 
 ATERM_POOL_STORAGE_TEMPLATES
-void ATERM_POOL_STORAGE::sweep()
+void ATERM_POOL_STORAGE::call_deletion_hooks()
+{
+  if (m_deletion_hooks.empty())
+  {
+    return;
+  }
+
+  for (const Element& term : m_term_set)
+  {
+    if (!term.is_marked())
+    {
+      call_deletion_hook(&term);
+    }
+  }
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::sweep(bool call_hooks, heap_profile* profile)
 {
   // Iterate over all terms and removes the ones that are marked.
   for (auto it = m_term_set.begin(); it != m_term_set.end(); )
   {
     const Element& term = *it;
 
+    if (profile != nullptr)
+    {
+      if (term.is_marked())
+      {
+        profile->add_live(term.function(), term_size(term));
+      }
+      else
+      {
+        profile->add_freed(term.function(), term_size(term));
+      }
+    }
+
     if (!term.is_marked())
     {
       // For constants, i.e., arity zero and integer terms we do not mark, but use their reachability directly. 
-      it = destroy(it);
+      it = destroy(it, call_hooks);
     }
     else
     {
@@ -409,11 +438,32 @@ void ATERM_POOL_STORAGE::sweep()
 ATERM_POOL_STORAGE_TEMPLATES
 void ATERM_POOL_STORAGE::resize_if_needed()
 {
-  m_term_set.rehash_if_needed();
+  // The elements are moved to the doubled table in steps, instead of rehashing all terms at once.
+  if (!m_term_set.rehash_in_progress() && m_term_set.load_factor() >= m_term_set.max_load_factor())
+  {
+    m_term_set.start_incremental_rehash();
+  }
+
+  m_term_set.rehash_step(IncrementalRehashStep);
 }
 
 /// PRIVATE FUNCTIONS
 
+ATERM_POOL_STORAGE_TEMPLATES
+std::size_t ATERM_POOL_STORAGE::term_size(const Element& term)
+{
+  if constexpr (N == DynamicNumberOfArguments)
+  {
+    // The same size as allocated by the _aterm_appl_allocator.
+    return sizeof(Element) + (term.function().arity() - 1) * sizeof(aterm);
+  }
+  else
+  {
+    mcrl2::utilities::mcrl2_unused(term);
+    return sizeof(Element);
+  }
+}
+
 ATERM_POOL_STORAGE_TEMPLATES
 void ATERM_POOL_STORAGE::call_deletion_hook(unprotected_aterm term)
 {
@@ -461,13 +511,16 @@ bool ATERM_POOL_STORAGE::verify_sweep()
 /// Private definitions
 
 ATERM_POOL_STORAGE_TEMPLATES
-typename ATERM_POOL_STORAGE::iterator ATERM_POOL_STORAGE::destroy(iterator it)
+typename ATERM_POOL_STORAGE::iterator ATERM_POOL_STORAGE::destroy(iterator it, bool call_hook)
 {
   // Store the term temporarily to be able to deallocate it after removing it from the set.
   const Element& term = *it;
 
   // Trigger the deletion hook before the term is actually destroyed.
-  call_deletion_hook(&term);
+  if (call_hook)
+  {
+    call_deletion_hook(&term);
+  }
 
   // Remove them from the hash table, will also destroy terms with fixed arity.
   return m_term_set.erase(it);
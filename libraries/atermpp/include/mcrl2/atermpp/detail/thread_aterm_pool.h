@@ -119,6 +119,11 @@ public:
   /// \brief Waits for the global term pool.
   inline void wait();
 
+  /// \brief Called after a new term has been added to the global term pool.
+  /// \details Consumes the local budget for creating terms, and obtains a new budget from the
+  ///          global term pool when it is exhausted.
+  inline void created_term();
+
   /// \brief Deliver the busy flag to rewriters for faster access.
   /// \details This is a performance optimisation to be deleted in due time. 
   inline std::atomic<bool>* get_busy_flag()
@@ -150,6 +155,13 @@ private:
   std::size_t m_variable_insertions = 0;
   std::size_t m_container_insertions = 0;
 
+  /// The number of terms that this thread can create before it must update the counters of the global pool.
+  long m_creation_budget = 0;
+
+  /// The number of terms created by this thread, and the number of times that it obtained a new budget.
+  std::size_t m_created_terms = 0;
+  std::size_t m_budget_reservations = 0;
+
   /// \brief A boolean flag indicating whether this thread is working inside the global aterm pool.
   std::atomic<bool> m_busy_flag = false;
   std::atomic<bool> m_forbidden_flag = false;
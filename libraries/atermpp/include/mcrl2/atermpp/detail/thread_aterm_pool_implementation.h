@@ -43,7 +43,7 @@ void thread_aterm_pool::create_int(aterm& term, size_t val)
   lock_shared();
   bool added = m_pool.create_int(term, val);
   unlock_shared();
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 void thread_aterm_pool::create_term(aterm& term, const atermpp::function_symbol& sym)
@@ -51,7 +51,7 @@ void thread_aterm_pool::create_term(aterm& term, const atermpp::function_symbol&
   lock_shared();
   bool added = m_pool.create_term(term, sym);
   unlock_shared();
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 template<class ...Terms>
@@ -60,7 +60,7 @@ void thread_aterm_pool::create_appl(aterm& term, const function_symbol& sym, con
   lock_shared();
   bool added = m_pool.create_appl(term, sym, arguments...);
   unlock_shared();
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 template<class Term, class INDEX_TYPE, class ...Terms>
@@ -98,7 +98,7 @@ void thread_aterm_pool::create_appl_index(aterm& term, const function_symbol& sy
 
   unlock_shared();
 
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 template<typename InputIterator>
@@ -111,7 +111,7 @@ void thread_aterm_pool::create_appl_dynamic(aterm& term,
   bool added = m_pool.create_appl_dynamic(term, sym, begin, end);
   unlock_shared();
   
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 template<typename InputIterator, typename ATermConverter>
@@ -125,7 +125,7 @@ void thread_aterm_pool::create_appl_dynamic(aterm& term,
   bool added = m_pool.create_appl_dynamic(term, sym, convert_to_aterm, begin, end);
   unlock_shared();
 
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 void thread_aterm_pool::register_variable(aterm* variable)
@@ -212,8 +212,24 @@ void thread_aterm_pool::mark()
   }
 }
 
+void thread_aterm_pool::created_term()
+{
+  ++m_created_terms;
+  if (--m_creation_budget <= 0)
+  {
+    ++m_budget_reservations;
+    m_creation_budget = m_pool.reserve_creation_budget(m_lock_depth == 0, this);
+  }
+}
+
 void thread_aterm_pool::print_local_performance_statistics() const
 {
+  if constexpr (EnableGarbageCollectionMetrics)
+  {
+    mCRL2log(mcrl2::log::info, "Performance") << "thread_aterm_pool: " << m_created_terms << " terms created, for which a budget was reserved "
+                                              << m_budget_reservations << " times.\n";
+  }
+
   if constexpr (EnableVariableRegistrationMetrics)
   {
     mCRL2log(mcrl2::log::info, "Performance") << "thread_aterm_pool: " << m_variables->size() << " variables in root set (" << m_variable_insertions << " total insertions)"
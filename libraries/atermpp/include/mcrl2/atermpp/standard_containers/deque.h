@@ -223,6 +223,12 @@ public:
     super::emplace_front(args...);
   }
 
+  void pop_front()
+  {
+    detail::shared_guard _;
+    super::pop_front();
+  }
+
   void resize( size_type count )
   {
     detail::shared_guard _;
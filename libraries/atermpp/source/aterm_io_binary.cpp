@@ -9,6 +9,8 @@
 
 #include "mcrl2/atermpp/aterm_io_binary.h"
 
+#include <thread>
+
 namespace atermpp
 {
 using namespace mcrl2::utilities;
@@ -32,7 +34,10 @@ static constexpr std::uint16_t BAF_MAGIC = 0x8baf;
 ///  2 April 2017     : version changed to 0x0304 (removed a few superfluous fields in the format)
 /// 19 July 2019      : version changed to 0x8305 (introduction of the streamable aterm format)
 /// 28 February 2020  : version changed to 0x8306 (added ability to stream aterm_int, implemented structured streaming for all objects)
+/// 18 October 2026   : version 0x8307 is the chunked format, written by chunked_binary_aterm_ostream. Streams of
+///                     version 0x8306 are still written by binary_aterm_ostream, and both versions can be read.
 static constexpr std::uint16_t BAF_VERSION = 0x8306;
+static constexpr std::uint16_t BAF_CHUNKED_VERSION = 0x8307;
 
 /// \brief Each packet has a header consisting of a type.
 /// \details Either indicates a function symbol, a term (either shared or output) or an arbitrary integer.
@@ -60,8 +65,8 @@ binary_aterm_ostream::binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obi
   m_stream->write_bits(BAF_VERSION, 16);  
 }
 
-binary_aterm_ostream::binary_aterm_ostream(std::ostream& stream)
-  : binary_aterm_ostream(std::make_shared<mcrl2::utilities::obitstream>(stream))
+binary_aterm_ostream::binary_aterm_ostream(std::ostream& stream, bool compress)
+  : binary_aterm_ostream(std::make_shared<mcrl2::utilities::obitstream>(stream, compress))
 {}
 
 binary_aterm_ostream::~binary_aterm_ostream()
@@ -82,8 +87,15 @@ struct write_todo
   {}
 };
 
-void binary_aterm_ostream::put(const aterm& term)
+namespace detail
 {
+
+/// \brief Writes the term to the stream of the writer, which is a binary_aterm_ostream or a binary_aterm_chunk.
+template <typename Writer>
+void write_term(Writer& writer, const aterm& term)
+{
+  obitstream& stream = *writer.m_stream;
+
   // Traverse the term bottom up and store the subterms (and function symbol) before the actual term.
   std::stack<write_todo> stack;
   stack.emplace(static_cast<const aterm_appl&>(term));
@@ -91,11 +103,11 @@ void binary_aterm_ostream::put(const aterm& term)
   do
   {
     write_todo& current = stack.top();
-    aterm_appl transformed = m_transformer(current.term);
+    aterm_appl transformed = writer.m_transformer(current.term);
 
     // Indicates that this term is output and not a subterm, these should always be written.
     bool is_output = stack.size() == 1;
-    if (m_terms.index(current.term) >= m_terms.size() || is_output)
+    if (writer.m_terms.index(current.term) >= writer.m_terms.size() || is_output)
     {
       if (current.write)
       {
@@ -104,41 +116,41 @@ void binary_aterm_ostream::put(const aterm& term)
           if (is_output)
           {
             // If the integer is output, write the header and just an integer
-            m_stream->write_bits(static_cast<std::size_t>(packet_type::aterm_int_output), packet_bits);
-            m_stream->write_integer(reinterpret_cast<const aterm_int&>(current.term).value());
+            stream.write_bits(static_cast<std::size_t>(packet_type::aterm_int_output), packet_bits);
+            stream.write_integer(reinterpret_cast<const aterm_int&>(current.term).value());
           }
           else
           {
-            std::size_t symbol_index = write_function_symbol(transformed.function());
+            std::size_t symbol_index = writer.write_function_symbol(transformed.function());
 
             // Write the packet identifier of an aterm_int followed by its value.
-            m_stream->write_bits(static_cast<std::size_t>(packet_type::aterm), packet_bits);
-            m_stream->write_bits(symbol_index, function_symbol_index_width());
-            m_stream->write_integer(reinterpret_cast<const aterm_int&>(current.term).value());
+            stream.write_bits(static_cast<std::size_t>(packet_type::aterm), packet_bits);
+            stream.write_bits(symbol_index, writer.function_symbol_index_width());
+            stream.write_integer(reinterpret_cast<const aterm_int&>(current.term).value());
           }
         }
         else
         {
-          std::size_t symbol_index = write_function_symbol(transformed.function());
+          std::size_t symbol_index = writer.write_function_symbol(transformed.function());
 
           // Write the packet identifier, followed by the indices of its function symbol and arguments.
-          m_stream->write_bits(static_cast<std::size_t>(is_output ? packet_type::aterm_output : packet_type::aterm), packet_bits);
-          m_stream->write_bits(symbol_index, function_symbol_index_width());
+          stream.write_bits(static_cast<std::size_t>(is_output ? packet_type::aterm_output : packet_type::aterm), packet_bits);
+          stream.write_bits(symbol_index, writer.function_symbol_index_width());
 
           for (const aterm& argument : transformed)
           {
-            std::size_t index = m_terms.index(argument);
-            assert(index < m_terms.size()); // Every argument must already be written.
-            m_stream->write_bits(index, term_index_width());
+            std::size_t index = writer.m_terms.index(argument);
+            assert(index < writer.m_terms.size()); // Every argument must already be written.
+            stream.write_bits(index, writer.term_index_width());
           }
         }
 
         if (!is_output)
         {
           // Only regular terms (not output) are shared and as such need a unique index.
-          bool assigned = m_terms.insert(current.term).second;
+          bool assigned = writer.m_terms.insert(current.term).second;
           assert(assigned); mcrl2_unused(assigned); // This term should have a new index assigned.
-          m_term_index_width = static_cast<std::uint8_t>(std::log2(m_terms.size()) + 1);
+          writer.m_term_index_width = static_cast<std::uint8_t>(std::log2(writer.m_terms.size()) + 1);
         }
 
         stack.pop();
@@ -149,7 +161,7 @@ void binary_aterm_ostream::put(const aterm& term)
         for (const aterm& argument : transformed)
         {
           const aterm_appl& term = static_cast<const aterm_appl&>(argument);
-          if (m_terms.index(term) >= m_terms.size())
+          if (writer.m_terms.index(term) >= writer.m_terms.size())
           {
             // Only add arguments that have not been written before.
             stack.emplace(term);
@@ -168,6 +180,13 @@ void binary_aterm_ostream::put(const aterm& term)
   while (!stack.empty());
 }
 
+} // namespace detail
+
+void binary_aterm_ostream::put(const aterm& term)
+{
+  detail::write_term(*this, term);
+}
+
 unsigned int binary_aterm_ostream::term_index_width()
 {
   assert(m_term_index_width == static_cast<unsigned int>(std::log2(m_terms.size()) + 1));
@@ -180,6 +199,307 @@ unsigned int binary_aterm_ostream::function_symbol_index_width()
   return m_function_symbol_index_width;
 }
 
+namespace detail
+{
+
+/// \brief Reads the next output term from the stream of the reader, which is a binary_aterm_istream or
+///        a chunk_decoder. Function symbol packets are handled by the reader.
+template <typename Reader>
+aterm read_term(Reader& reader)
+{
+  ibitstream& stream = *reader.m_stream;
+  while(true)
+  {
+    // Determine the type of the next packet.
+    std::size_t header = stream.read_bits(packet_bits);
+    packet_type packet = static_cast<packet_type>(header);
+
+    if (packet == packet_type::function_symbol)
+    {
+      reader.read_function_symbol();
+    }
+    else if (packet == packet_type::aterm_int_output)
+    {
+      // Read the integer from the stream and construct an aterm_int.
+      std::size_t value = stream.read_integer();
+      return aterm_int(value);
+    }
+    else if (packet == packet_type::aterm || packet == packet_type::aterm_output)
+    {
+      // First read the function symbol of the following term.
+      function_symbol symbol = reader.m_function_symbols[stream.read_bits(reader.function_symbol_index_width())];
+
+      if (!symbol.defined())
+      {
+        // The term with function symbol zero marks the end of the stream.
+        return aterm();
+      }
+      else if (symbol == detail::g_as_int)
+      {
+        // Read the integer from the stream and construct a shared aterm_int in the index.
+        std::size_t value = stream.read_integer();
+        reader.m_terms.emplace_back(aterm_int(value));
+        reader.m_term_index_width = static_cast<unsigned int>(std::log2(reader.m_terms.size()) + 1);
+      }
+      else
+      {
+        // Read arity number of arguments from the stream and search them in the already defined set of terms.
+        std::vector<aterm> arguments(symbol.arity());
+        for (std::size_t argument = 0; argument < symbol.arity(); ++argument)
+        {
+          arguments[argument] = reader.m_terms[stream.read_bits(reader.term_index_width())];
+        }
+
+        // Transform the resulting term.
+        aterm transformed = reader.m_transformer(aterm_appl(symbol, arguments.begin(), arguments.end()));
+
+        if (packet == packet_type::aterm_output)
+        {
+          // This aterm was marked as output in the file so return it.
+          return transformed;
+        }
+        else
+        {
+          // Construct the term appl from the function symbol and the already read arguments and insert it.
+          reader.m_terms.emplace_back(transformed);
+          reader.m_term_index_width = static_cast<unsigned int>(std::log2(reader.m_terms.size()) + 1);
+        }
+      }
+    }
+  }
+}
+
+/// \brief A chunk of the chunked binary aterm format that has been read from the stream.
+struct aterm_chunk
+{
+  std::size_t number_of_terms = 0;
+  std::vector<function_symbol> function_symbols; ///< The function symbols of this chunk, where index 0 is not used.
+  std::string payload; ///< The encoded terms.
+
+  std::vector<aterm> terms; ///< The decoded terms, if they have been decoded in advance.
+  aterm_transformer* transformer = nullptr; ///< The transformer used to decode the terms, or nullptr if they have not been decoded.
+};
+
+/// \brief Decodes the terms of a chunk one by one.
+class chunk_decoder
+{
+public:
+  chunk_decoder(const aterm_chunk& chunk)
+   : m_buffer(chunk.payload),
+     m_stream(std::make_shared<ibitstream>(m_buffer, false)),
+     m_function_symbols(chunk.function_symbols)
+  {}
+
+  /// \brief Decodes the next term of the chunk using the given transformer.
+  aterm get(aterm_transformer* transformer)
+  {
+    m_transformer = transformer;
+    return read_term(*this);
+  }
+
+private:
+  template <typename Reader>
+  friend aterm read_term(Reader& reader);
+
+  void read_function_symbol()
+  {
+    // The function symbol with the next index becomes available.
+    ++m_number_of_function_symbols;
+    m_function_symbol_index_width = static_cast<unsigned int>(std::log2(m_number_of_function_symbols) + 1);
+    if (m_number_of_function_symbols > m_function_symbols.size())
+    {
+      throw mcrl2::runtime_error("Error while reading: a chunk of the binary aterm stream is corrupt.");
+    }
+  }
+
+  unsigned int term_index_width()
+  {
+    return m_term_index_width;
+  }
+
+  unsigned int function_symbol_index_width()
+  {
+    return m_function_symbol_index_width;
+  }
+
+  std::istringstream m_buffer;
+  std::shared_ptr<ibitstream> m_stream;
+  const std::vector<function_symbol>& m_function_symbols;
+  std::size_t m_number_of_function_symbols = 1;
+  unsigned int m_function_symbol_index_width = 1;
+  unsigned int m_term_index_width = 0;
+  std::deque<aterm> m_terms;
+  aterm_transformer* m_transformer = identity;
+};
+
+/// \brief Reads the chunks of a stream in the chunked binary aterm format, and returns their terms in order.
+/// \details Chunks are read in batches of one chunk per thread, that are decoded in parallel. A decoded term
+///          depends on the transformer of the stream. If the transformer at the moment the term is requested
+///          differs from the one with which it was decoded, the chunk is decoded again sequentially.
+class chunked_aterm_reader
+{
+public:
+  chunked_aterm_reader(std::shared_ptr<ibitstream> stream)
+   : m_stream(stream),
+     m_number_of_threads(GlobalThreadSafe ? std::max(1u, std::thread::hardware_concurrency()) : 1)
+  {}
+
+  aterm get(aterm_transformer* transformer)
+  {
+    while (m_chunks.empty())
+    {
+      if (m_end)
+      {
+        return aterm();
+      }
+      read_chunks(transformer);
+    }
+
+    aterm_chunk& chunk = m_chunks.front();
+    aterm result;
+    if (m_decoder == nullptr && chunk.transformer == transformer)
+    {
+      result = chunk.terms[m_position];
+    }
+    else
+    {
+      if (m_decoder == nullptr)
+      {
+        // Decode the terms before the current position as they were decoded before.
+        m_decoder = std::make_unique<chunk_decoder>(chunk);
+        for (std::size_t i = 0; i < m_position; ++i)
+        {
+          m_decoder->get(chunk.transformer);
+        }
+      }
+      result = m_decoder->get(transformer);
+    }
+
+    ++m_position;
+    if (m_position == chunk.number_of_terms)
+    {
+      m_decoder.reset();
+      m_chunks.pop_front();
+      m_position = 0;
+    }
+    return result;
+  }
+
+private:
+  /// \brief Reads the next chunk into the given chunk.
+  /// \returns False iff the end of the stream has been reached.
+  bool read_chunk(aterm_chunk& chunk)
+  {
+    chunk.number_of_terms = m_stream->read_integer();
+    if (chunk.number_of_terms == 0)
+    {
+      return false;
+    }
+
+    // Add the new function symbols to the table.
+    std::size_t number_of_new_function_symbols = m_stream->read_integer();
+    for (std::size_t i = 0; i < number_of_new_function_symbols; ++i)
+    {
+      std::string name = m_stream->read_string();
+      std::size_t arity = m_stream->read_integer();
+      m_function_symbols.emplace_back(name, arity);
+    }
+
+    std::size_t number_of_function_symbols = m_stream->read_integer();
+    chunk.function_symbols.reserve(number_of_function_symbols + 1);
+    chunk.function_symbols.emplace_back();
+    for (std::size_t i = 0; i < number_of_function_symbols; ++i)
+    {
+      std::size_t index = m_stream->read_integer();
+      if (index >= m_function_symbols.size())
+      {
+        throw mcrl2::runtime_error("Error while reading: a chunk of the binary aterm stream refers to an unknown function symbol.");
+      }
+      chunk.function_symbols.push_back(m_function_symbols[index]);
+    }
+
+    chunk.payload.resize(m_stream->read_integer());
+    m_stream->read(chunk.payload.size(), reinterpret_cast<std::uint8_t*>(&chunk.payload[0]));
+    return true;
+  }
+
+  /// \brief Reads a batch of chunks, and decodes them in parallel with the given transformer if there is more than one.
+  void read_chunks(aterm_transformer* transformer)
+  {
+    std::size_t first = m_chunks.size();
+    while (!m_end && m_chunks.size() - first < m_number_of_threads)
+    {
+      m_chunks.emplace_back();
+      if (!read_chunk(m_chunks.back()))
+      {
+        m_chunks.pop_back();
+        m_end = true;
+      }
+    }
+
+    const std::size_t number_of_chunks = m_chunks.size() - first;
+    if (number_of_chunks <= 1)
+    {
+      return;
+    }
+
+    // The terms are created by this thread, such that they are protected by it, and assigned by the decoding threads.
+    for (std::size_t i = first; i < m_chunks.size(); ++i)
+    {
+      m_chunks[i].terms.resize(m_chunks[i].number_of_terms);
+    }
+
+    std::vector<std::exception_ptr> exceptions(number_of_chunks);
+    auto decode = [&](std::size_t i)
+    {
+      try
+      {
+        aterm_chunk& chunk = m_chunks[first + i];
+        chunk_decoder decoder(chunk);
+        for (aterm& term : chunk.terms)
+        {
+          term = decoder.get(transformer);
+        }
+        chunk.transformer = transformer;
+      }
+      catch (...)
+      {
+        exceptions[i] = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < number_of_chunks; ++i)
+    {
+      threads.emplace_back(decode, i);
+    }
+    decode(0);
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (const std::exception_ptr& e : exceptions)
+    {
+      if (e)
+      {
+        std::rethrow_exception(e);
+      }
+    }
+  }
+
+  std::shared_ptr<ibitstream> m_stream;
+  std::size_t m_number_of_threads;
+  bool m_end = false;
+
+  std::vector<function_symbol> m_function_symbols; ///< The table of function symbols of all chunks.
+  std::deque<aterm_chunk> m_chunks; ///< The chunks that have been read, of which not all terms have been returned.
+  std::size_t m_position = 0; ///< The position of the next term in the first chunk.
+  std::unique_ptr<chunk_decoder> m_decoder; ///< Decodes the first chunk sequentially, if needed.
+};
+
+} // namespace detail
+
 binary_aterm_istream::binary_aterm_istream(std::shared_ptr<mcrl2::utilities::ibitstream> stream)
   : m_stream(stream)
 {
@@ -194,7 +514,11 @@ binary_aterm_istream::binary_aterm_istream(std::shared_ptr<mcrl2::utilities::ibi
   }
 
   std::size_t version = m_stream->read_bits(16);
-  if (version != BAF_VERSION)
+  if (version == BAF_CHUNKED_VERSION)
+  {
+    m_chunks = std::make_unique<detail::chunked_aterm_reader>(m_stream);
+  }
+  else if (version != BAF_VERSION)
   {
     throw mcrl2::runtime_error("The BAF version (" + std::to_string(version) + ") of the input file is incompatible with the version (" + std::to_string(BAF_VERSION) +
                                ") of this tool. The input file must be regenerated. ");
@@ -205,6 +529,8 @@ binary_aterm_istream::binary_aterm_istream(std::istream& is)
   : binary_aterm_istream(std::make_shared<mcrl2::utilities::ibitstream>(is))
 {}
 
+binary_aterm_istream::~binary_aterm_istream() = default;
+
 std::size_t binary_aterm_ostream::write_function_symbol(const function_symbol& symbol)
 {
   std::size_t result = m_function_symbols.index(symbol);
@@ -227,85 +553,192 @@ std::size_t binary_aterm_ostream::write_function_symbol(const function_symbol& s
   }
 }
 
+void binary_aterm_istream::read_function_symbol()
+{
+  // Read a single function symbol and insert it into the already read function symbols.
+  std::string name = m_stream->read_string();
+  std::size_t arity = m_stream->read_integer();
+  m_function_symbols.emplace_back(name, arity);
+  m_function_symbol_index_width = static_cast<unsigned int>(std::log2(m_function_symbols.size()) + 1);
+}
+
 aterm binary_aterm_istream::get()
 {
-  while(true)
+  if (m_chunks)
   {
-    // Determine the type of the next packet.
-    std::size_t header = m_stream->read_bits(packet_bits);
-    packet_type packet = static_cast<packet_type>(header);
+    return m_chunks->get(m_transformer);
+  }
+  return detail::read_term(*this);
+}
 
-    if (packet == packet_type::function_symbol)
-    {
-      // Read a single function symbol and insert it into the already read function symbols.
-      std::string name = m_stream->read_string();
-      std::size_t arity = m_stream->read_integer();
-      m_function_symbols.emplace_back(name, arity);
-      m_function_symbol_index_width = static_cast<unsigned int>(std::log2(m_function_symbols.size()) + 1);
-    }
-    else if (packet == packet_type::aterm_int_output)
-    {
-      // Read the integer from the stream and construct an aterm_int.
-      std::size_t value = m_stream->read_integer();
-      return aterm_int(value);
-    }
-    else if (packet == packet_type::aterm || packet == packet_type::aterm_output)
-    {
-      // First read the function symbol of the following term.
-      function_symbol symbol = m_function_symbols[m_stream->read_bits(function_symbol_index_width())];
+unsigned int binary_aterm_istream::term_index_width()
+{
+  assert(m_term_index_width == static_cast<unsigned int>(std::log2(m_terms.size()) + 1));
+  return m_term_index_width;
+}
 
-      if (!symbol.defined())
-      {
-        // The term with function symbol zero marks the end of the stream.
-        return aterm();
-      }
-      else if (symbol == detail::g_as_int)
-      {
-        // Read the integer from the stream and construct a shared aterm_int in the index.
-        std::size_t value = m_stream->read_integer();
-        m_terms.emplace_back(aterm_int(value));
-        m_term_index_width = static_cast<unsigned int>(std::log2(m_terms.size()) + 1);
-      }
-      else
-      {
-        // Read arity number of arguments from the stream and search them in the already defined set of terms.
-        std::vector<aterm> arguments(symbol.arity());
-        for (std::size_t argument = 0; argument < symbol.arity(); ++argument)
-        {
-          arguments[argument] = m_terms[m_stream->read_bits(term_index_width())];
-        }
+unsigned int binary_aterm_istream::function_symbol_index_width()
+{
+  assert(m_function_symbol_index_width == static_cast<unsigned int>(std::log2(m_function_symbols.size()) + 1));
+  return m_function_symbol_index_width;
+}
 
-        // Transform the resulting term.
-        aterm transformed = m_transformer(aterm_appl(symbol, arguments.begin(), arguments.end()));
+binary_aterm_chunk::binary_aterm_chunk()
+{
+  clear();
+}
 
-        if (packet == packet_type::aterm_output)
-        {
-          // This aterm was marked as output in the file so return it.
-          return transformed;
-        }
-        else
-        {
-          // Construct the term appl from the function symbol and the already read arguments and insert it.
-          m_terms.emplace_back(transformed);
-          m_term_index_width = static_cast<unsigned int>(std::log2(m_terms.size()) + 1);
-        }
-      }
-    }
+void binary_aterm_chunk::put(const aterm& term)
+{
+  detail::write_term(*this, term);
+  ++m_number_of_terms;
+}
+
+void binary_aterm_chunk::clear()
+{
+  // Destroying the bit stream flushes the remaining bits to the buffer, which is emptied afterwards.
+  m_stream.reset();
+  m_buffer.str(std::string());
+  m_buffer.clear();
+  m_stream = std::make_shared<obitstream>(m_buffer, false);
+  m_number_of_terms = 0;
+
+  m_terms.clear();
+  m_function_symbols.clear();
+
+  // As in the streamable format the function symbol with index 0 is not used, which is not stored in the chunk.
+  m_function_symbols.insert(function_symbol("end_of_stream", 0));
+  m_function_symbol_index_width = 1;
+}
+
+std::size_t binary_aterm_chunk::write_function_symbol(const function_symbol& symbol)
+{
+  std::size_t result = m_function_symbols.index(symbol);
+
+  if (result < m_function_symbols.size())
+  {
+    return result;
+  }
+  else
+  {
+    // Only the packet is written. The function symbol itself is stored in the header of the chunk.
+    m_stream->write_bits(static_cast<std::size_t>(packet_type::function_symbol), packet_bits);
+
+    auto result = m_function_symbols.insert(symbol);
+    m_function_symbol_index_width = static_cast<unsigned int>(std::log2(m_function_symbols.size()) + 1);
+
+    return result.first;
   }
 }
 
-unsigned int binary_aterm_istream::term_index_width()
+unsigned int binary_aterm_chunk::term_index_width()
 {
   assert(m_term_index_width == static_cast<unsigned int>(std::log2(m_terms.size()) + 1));
   return m_term_index_width;
 }
 
-unsigned int binary_aterm_istream::function_symbol_index_width()
+unsigned int binary_aterm_chunk::function_symbol_index_width()
 {
   assert(m_function_symbol_index_width == static_cast<unsigned int>(std::log2(m_function_symbols.size()) + 1));
   return m_function_symbol_index_width;
 }
 
+chunked_binary_aterm_ostream::chunked_binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obitstream> stream, std::size_t chunk_size)
+  : m_stream(stream),
+    m_chunk_size(chunk_size)
+{
+  // Write the header of the binary aterm format.
+  m_stream->write_bits(0, 8);
+  m_stream->write_bits(BAF_MAGIC, 16);
+  m_stream->write_bits(BAF_CHUNKED_VERSION, 16);
+}
+
+chunked_binary_aterm_ostream::chunked_binary_aterm_ostream(std::ostream& stream, std::size_t chunk_size, bool compress)
+  : chunked_binary_aterm_ostream(std::make_shared<mcrl2::utilities::obitstream>(stream, compress), chunk_size)
+{}
+
+chunked_binary_aterm_ostream::~chunked_binary_aterm_ostream()
+{
+  if (m_chunk.number_of_terms() > 0)
+  {
+    append(m_chunk);
+  }
+
+  // A chunk without terms indicates the end of the stream.
+  m_stream->write_integer(0);
+}
+
+void chunked_binary_aterm_ostream::put(const aterm& term)
+{
+  // All terms in a chunk are written with the same transformer, such that a reader that uses the corresponding
+  // transformers typically changes its transformer at the boundary of a chunk.
+  if (m_chunk.get_transformer() != m_transformer)
+  {
+    if (m_chunk.number_of_terms() > 0)
+    {
+      append(m_chunk);
+    }
+    m_chunk.set_transformer(m_transformer);
+  }
+
+  m_chunk.put(term);
+  if (m_chunk.size() >= m_chunk_size)
+  {
+    append(m_chunk);
+  }
+}
+
+void chunked_binary_aterm_ostream::append(binary_aterm_chunk& chunk)
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  write_chunk(chunk);
+}
+
+void chunked_binary_aterm_ostream::write_chunk(binary_aterm_chunk& chunk)
+{
+  if (chunk.number_of_terms() == 0)
+  {
+    return;
+  }
+
+  // Flush the remaining bits of the encoded terms.
+  chunk.m_stream.reset();
+  const std::string payload = chunk.m_buffer.str();
+
+  // Determine the function symbols that are new to the table, and the indices of the function symbols of this chunk.
+  std::vector<function_symbol> new_function_symbols;
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 1; i < chunk.m_function_symbols.size(); ++i)
+  {
+    const function_symbol& symbol = chunk.m_function_symbols[i];
+    auto [index, inserted] = m_function_symbols.insert(symbol);
+    if (inserted)
+    {
+      new_function_symbols.push_back(symbol);
+    }
+    indices.push_back(index);
+  }
+
+  m_stream->write_integer(chunk.number_of_terms());
+  m_stream->write_integer(new_function_symbols.size());
+  for (const function_symbol& symbol : new_function_symbols)
+  {
+    m_stream->write_string(symbol.name());
+    m_stream->write_integer(symbol.arity());
+  }
+
+  m_stream->write_integer(indices.size());
+  for (std::size_t index : indices)
+  {
+    m_stream->write_integer(index);
+  }
+
+  m_stream->write_integer(payload.size());
+  m_stream->write(reinterpret_cast<const std::uint8_t*>(payload.data()), payload.size());
+
+  chunk.clear();
+}
+
 void write_term_to_binary_stream(const aterm& t, std::ostream& os)
 {
   binary_aterm_ostream(os) << t;
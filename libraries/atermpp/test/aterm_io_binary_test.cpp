@@ -9,6 +9,9 @@
 
 #include "mcrl2/atermpp/aterm_io_binary.h"
 
+#include <set>
+#include <thread>
+
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/included/unit_test.hpp>
 
@@ -98,3 +101,133 @@ BOOST_AUTO_TEST_CASE(transitions_test)
     BOOST_CHECK_EQUAL(input.get(), sequence[index]);
   }
 }
+
+// Renames the function symbol f to g, to check that transformers are applied per chunk.
+static aterm_appl rename_f(const aterm_appl& term)
+{
+  if (term.function() == function_symbol("f", 1))
+  {
+    return aterm_appl(function_symbol("g", 1), term[0]);
+  }
+  return term;
+}
+
+BOOST_AUTO_TEST_CASE(chunked_stream_test)
+{
+  std::vector<aterm> sequence;
+  function_symbol f("f", 1);
+  aterm_list list;
+  for (std::size_t index = 0; index < 5000; ++index)
+  {
+    list.push_front(aterm_int(index % 100));
+    sequence.push_back(aterm_appl(f, list));
+    sequence.push_back(aterm_int(index));
+  }
+
+  // Use small chunks, such that there are many of them and the reader decodes them in parallel.
+  std::stringstream stream;
+  {
+    chunked_binary_aterm_ostream output(stream, 512);
+    for (const aterm& term : sequence)
+    {
+      output << term;
+    }
+  }
+
+  binary_aterm_istream input(stream);
+  for (std::size_t index = 0; index < sequence.size(); ++index)
+  {
+    // Change the transformer halfway, after which the terms must be decoded again.
+    if (index == sequence.size() / 2)
+    {
+      input >> rename_f;
+    }
+
+    aterm term = input.get();
+    if (index >= sequence.size() / 2 && term.type_is_appl() && !term.type_is_list())
+    {
+      BOOST_CHECK_EQUAL(term, rename_f(down_cast<aterm_appl>(sequence[index])));
+    }
+    else
+    {
+      BOOST_CHECK_EQUAL(term, sequence[index]);
+    }
+  }
+  BOOST_CHECK(!input.get().defined());
+}
+
+BOOST_AUTO_TEST_CASE(chunked_stream_append_test)
+{
+  function_symbol f("f", 2);
+  const std::size_t number_of_producers = 4;
+
+  std::stringstream stream;
+  {
+    chunked_binary_aterm_ostream output(stream);
+
+    std::vector<std::thread> producers;
+    for (std::size_t producer = 0; producer < number_of_producers; ++producer)
+    {
+      producers.emplace_back([&, producer]()
+        {
+          binary_aterm_chunk chunk;
+          chunk << aterm_appl(f, aterm_int(producer), aterm_appl(function_symbol("producer" + std::to_string(producer), 0)));
+          chunk << aterm_int(producer);
+          output.append(chunk);
+          BOOST_CHECK_EQUAL(chunk.number_of_terms(), 0u);
+        });
+    }
+
+    for (std::thread& producer : producers)
+    {
+      producer.join();
+    }
+  }
+
+  // Every chunk is read as a whole, in the order in which the chunks were appended.
+  binary_aterm_istream input(stream);
+  std::set<std::size_t> producers;
+  for (std::size_t i = 0; i < number_of_producers; ++i)
+  {
+    aterm_appl term = down_cast<aterm_appl>(input.get());
+    std::size_t producer = down_cast<aterm_int>(term[0]).value();
+    BOOST_CHECK_EQUAL(term, aterm_appl(f, aterm_int(producer), aterm_appl(function_symbol("producer" + std::to_string(producer), 0))));
+    BOOST_CHECK_EQUAL(input.get(), aterm_int(producer));
+    producers.insert(producer);
+  }
+  BOOST_CHECK_EQUAL(producers.size(), number_of_producers);
+  BOOST_CHECK(!input.get().defined());
+}
+
+BOOST_AUTO_TEST_CASE(compressed_stream_test)
+{
+  std::vector<aterm> sequence;
+  function_symbol f("f", 2);
+  for (std::size_t index = 0; index < 5000; ++index)
+  {
+    sequence.push_back(aterm_appl(f, aterm_int(index % 100), aterm_int(index)));
+  }
+
+  std::stringstream compressed;
+  std::stringstream chunked;
+  {
+    binary_aterm_ostream output(compressed, true);
+    chunked_binary_aterm_ostream chunked_output(chunked, 512, true);
+    for (const aterm& term : sequence)
+    {
+      output << term;
+      chunked_output << term;
+    }
+  }
+
+  // The compression is detected by the reader.
+  binary_aterm_istream input(compressed);
+  binary_aterm_istream chunked_input(chunked);
+  for (const aterm& term : sequence)
+  {
+    BOOST_CHECK_EQUAL(input.get(), term);
+    BOOST_CHECK_EQUAL(chunked_input.get(), term);
+  }
+  BOOST_CHECK(!input.get().defined());
+  BOOST_CHECK(!chunked_input.get().defined());
+}
@@ -0,0 +1,70 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file heap_profile_test.cpp
+/// \brief Test the heap profile of the term pool.
+
+#define BOOST_TEST_MODULE heap_profile_test
+#include <boost/test/included/unit_test.hpp>
+
+#include "mcrl2/atermpp/aterm_appl.h"
+#include "mcrl2/atermpp/aterm_int.h"
+
+#include <sstream>
+
+using namespace atermpp;
+
+/// \returns The entry of the function symbol with the given name and arity in the profile.
+static std::string entry(const std::string& name, std::size_t arity, std::size_t live_terms, std::size_t live_bytes, std::size_t freed_terms, std::size_t freed_bytes)
+{
+  std::stringstream result;
+  result << "    - name: \"" << name << "\"\n"
+         << "      arity: " << arity << "\n"
+         << "      live_terms: " << live_terms << "\n"
+         << "      live_bytes: " << live_bytes << "\n"
+         << "      freed_terms: " << freed_terms << "\n"
+         << "      freed_bytes: " << freed_bytes << "\n";
+  return result.str();
+}
+
+BOOST_AUTO_TEST_CASE(test_heap_profile)
+{
+  function_symbol f("heap_profile_f", 1);
+  function_symbol g("heap_profile_g", 1);
+  function_symbol h("heap_profile_\"h\"", 9);
+
+  std::vector<aterm_appl> live;
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    live.emplace_back(f, aterm_int(i));
+  }
+  std::vector<aterm> arguments(9, aterm_int(0));
+  live.emplace_back(h, arguments.begin(), arguments.end());
+
+  {
+    std::vector<aterm_appl> garbage;
+    for (std::size_t i = 0; i < 50; ++i)
+    {
+      garbage.emplace_back(g, aterm_int(i));
+    }
+  }
+
+  std::stringstream profile;
+  detail::g_term_pool().write_heap_profile(profile);
+
+  const std::size_t size = sizeof(detail::_aterm_appl<1>);
+  BOOST_CHECK(profile.str().find(entry("heap_profile_f", 1, 100, 100 * size, 0, 0)) != std::string::npos);
+  BOOST_CHECK(profile.str().find(entry("heap_profile_g", 1, 0, 0, 50, 50 * size)) != std::string::npos);
+  BOOST_CHECK(profile.str().find(entry("heap_profile_\\\"h\\\"", 9, 1, size + 8 * sizeof(aterm), 0, 0)) != std::string::npos);
+
+  // The freed terms are no longer counted by the next collection.
+  std::stringstream next_profile;
+  detail::g_term_pool().write_heap_profile(next_profile);
+  BOOST_CHECK(next_profile.str().find(entry("heap_profile_f", 1, 100, 100 * size, 0, 0)) != std::string::npos);
+  BOOST_CHECK(next_profile.str().find("heap_profile_g") == std::string::npos);
+}
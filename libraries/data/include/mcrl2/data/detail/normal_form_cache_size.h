@@ -0,0 +1,54 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/normal_form_cache_size.h
+/// \brief Stores a static variable that indicates the maximal number of closed
+/// terms of which the jitty rewriter caches the normal form
+
+#ifndef MCRL2_DATA_DETAIL_NORMAL_FORM_CACHE_SIZE_H
+#define MCRL2_DATA_DETAIL_NORMAL_FORM_CACHE_SIZE_H
+
+#include <cstddef>
+
+namespace mcrl2 {
+
+namespace data {
+
+namespace detail {
+
+// Stores the maximum number of normal forms of closed terms that are cached by a rewriter.
+// The value 0 indicates that no normal forms are cached.
+template <class T> // note, T is only a dummy
+struct normal_form_cache_size
+{
+  static std::size_t max_normal_form_cache_size;
+};
+
+// Initialization
+template <class T>
+std::size_t normal_form_cache_size<T>::max_normal_form_cache_size = 0;
+
+inline
+void set_normal_form_cache_size(std::size_t size)
+{
+  normal_form_cache_size<std::size_t>::max_normal_form_cache_size = size;
+}
+
+inline
+std::size_t get_normal_form_cache_size()
+{
+  return normal_form_cache_size<std::size_t>::max_normal_form_cache_size;
+}
+
+} // namespace detail
+
+} // namespace data
+
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_DETAIL_NORMAL_FORM_CACHE_SIZE_H
@@ -13,6 +13,8 @@
 #include "mcrl2/data/detail/rewrite.h"
 #include "mcrl2/data/detail/rewrite/rewrite_stack.h"
 #include "mcrl2/data/detail/rewrite/strategy_rule.h"
+#include "mcrl2/utilities/cache_metric.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
 
 namespace mcrl2
 {
@@ -90,6 +92,14 @@ class RewriterJitty: public Rewriter
     class rewrite_stack m_rewrite_stack;     // Stack for intermediate rewrite results.
 
     std::vector<data_expression> rhs_for_constants_cache; // Cache that contains normal forms for constants. 
+
+    // A bounded cache with the normal forms of closed terms. It is only used if m_normal_form_cache_size is not zero. 
+    // As terms are maximally shared, looking up a term in this cache does not depend on its size. 
+    std::size_t m_normal_form_cache_size;
+    utilities::fifo_cache<data_expression, data_expression> m_normal_form_cache;
+    utilities::cache_metric m_normal_form_cache_metric;
+    bool m_rewriting_closed_term = false; // True if the term being rewritten is a subterm of a closed term, outside binders.
+
     std::map< function_symbol, data_equation_list > jitty_eqns;
     std::vector<strategy> jitty_strat;
 
@@ -116,6 +126,14 @@ class RewriterJitty: public Rewriter
                       const application& term,
                       substitution_type& sigma);
 
+    void rewrite_aux_closed_term(
+                      data_expression& result,
+                      const function_symbol& op,
+                      const application& term,
+                      substitution_type& sigma);
+
+    bool is_closed(const data_expression& t);
+
     void rewrite_aux_const_function_symbol(
                       data_expression& result,
                       const function_symbol& op,
@@ -127,6 +145,7 @@ class RewriterJitty: public Rewriter
 
     strategy create_a_cpp_function_based_strategy(const function_symbol& f, const data_specification& data_spec);
     strategy create_a_rewriting_based_strategy(const function_symbol& f, const data_equation_list& rules1);
+    strategy create_a_machine_number_based_strategy(const machine_number_function& native, const strategy& rules_strategy, std::size_t arity);
     strategy create_strategy(const function_symbol& f, const data_equation_list& rules1, const data_specification& data_spec);
     void rebuild_strategy(const data_specification& data_spec, const mcrl2::data::used_data_equation_selector& equation_selector);
 
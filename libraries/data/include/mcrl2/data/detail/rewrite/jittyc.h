@@ -38,11 +38,16 @@ typedef std::vector < sort_expression_list> sort_list_vector;
 ///        are inserted in it. By keeping the cache on the stack, the normal forms
 ///        in it will not be freed by the ATerm library, and can therefore be used
 ///        in the generated jittyc code.
+/// \details The generated code refers to the normal forms by their position in the
+///          cache, via the table relocated_terms that is set when the compiled rewriter
+///          is loaded. So, the compiled rewriter does not depend on the addresses of terms,
+///          and it can be reused by another process that fills the cache with the same terms.
 ///
 class normal_form_cache
 {
   private:
-    std::set<data_expression> m_lookup;
+    std::vector<data_expression> m_terms;
+    std::map<data_expression, std::size_t> m_lookup;
   public:
     normal_form_cache()
     { 
@@ -55,19 +60,34 @@ class normal_form_cache
     normal_form_cache& operator=(const normal_form_cache& ) = delete;
     normal_form_cache& operator=(normal_form_cache&& ) = delete;
   
+  /// \brief Stores t in the cache, if it is not there yet.
+  /// \return The position of t in the cache.
+  std::size_t index(const data_expression& t)
+  {
+    const auto i = m_lookup.emplace(t, m_terms.size());
+    if (i.second)
+    {
+      m_terms.push_back(t);
+    }
+    return i.first->second;
+  }
+
   /// \brief insert stores the normal form of t in the cache, and returns a string
   ///        that is a C++ representation of the stored normal form. This string can
   ///        be used by the generated rewriter as long as the cache object is alive,
-  ///        and its clear() method has not been called.
+  ///        and no terms have been added after loading the rewriter.
   /// \param t The term to normalize.
   /// \return A C++ string that evaluates to the cached normal form of t.
   ///
   std::string insert(const data_expression& t)
   {
-    std::stringstream ss;
-    const data_expression* cached_term = &*(m_lookup.insert(t).first);
-    ss << "*reinterpret_cast<const data_expression*>(" << (void*)(cached_term) << ")";
-    return ss.str();
+    return "relocated_terms[" + std::to_string(index(t)) + "]";
+  }
+
+  /// \brief The terms in the cache, in the order in which they have been inserted.
+  const std::vector<data_expression>& terms() const
+  {
+    return m_terms;
   }
 
   /// \brief Checks whether the cache is empty.
@@ -163,6 +183,7 @@ class RewriterCompilingJitty: public Rewriter
 
     std::shared_ptr<uncompiled_library> rewriter_so;
     std::shared_ptr<normal_form_cache> m_nf_cache;
+    function_symbol_vector m_constants; // The constants for which normal_forms_for_constants is set.
 
     // The rewriter maintains a copy of busy and forbidden flag,
     // to allow for faster access to them. These flags are used extensively and
@@ -188,7 +209,12 @@ class RewriterCompilingJitty: public Rewriter
     bool calc_nfs(const data_expression& t, variable_or_number_list nnfvars);
     void CleanupRewriteSystem();
     void BuildRewriteSystem();
-    void generate_code(const std::string& filename);
+    void initialise_function_tables();
+    void set_normal_forms_for_constants();
+    std::string compiled_rewriter_description(const std::string& compile_script);
+    void save_relocation_information(const std::string& filename);
+    bool load_relocation_information(const std::string& filename);
+    std::vector<std::string> generate_code(const std::string& filename);
     void generate_rewr_functions(std::ostream& s, const data::function_symbol& func, const data_equation_list& eqs);
     bool lift_rewrite_rule_to_right_arity(data_equation& e, const std::size_t requested_arity);
     sort_list_vector get_residual_sorts(const sort_expression& s, const std::size_t actual_arity, const std::size_t requested_arity);
@@ -217,6 +243,7 @@ struct rewriter_interface
   std::string caller_toolset_version;
   std::string status;
   RewriterCompilingJitty* rewriter;
+  const data_expression* relocated_terms;
   void (*rewrite_external)(data_expression& result, const data_expression& t, RewriterCompilingJitty*);
   void (*rewrite_cleanup)();
 };
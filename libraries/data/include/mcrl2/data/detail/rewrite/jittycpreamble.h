@@ -56,10 +56,18 @@ static void local_rewrite(data_expression& result, const data_expression& t)
   result=t;
 }
 
+// The terms and function symbols that are used in the generated code, in the order of the
+// normal_form_cache of the rewriter. They are set when the rewriter is loaded. The generated
+// code can be split over several translation units, each of which has its own copy. Only the
+// first translation unit defines init, and it passes these terms on to the other units.
+static const data_expression* relocated_terms = nullptr;
+
 //
 // Forward declarations
 //
+#ifndef MCRL2_JITTYC_ADDITIONAL_TRANSLATION_UNIT
 static void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter);
+#endif
 
 template <bool ARGUMENTS_IN_NORMAL_FORM>
 static void rewrite_aux(data_expression& result, const data_expression& t, RewriterCompilingJitty* this_rewriter);
@@ -416,6 +424,7 @@ void rewrite_aux(data_expression& result, const data_expression& t, RewriterComp
   }
 }
 
+#ifndef MCRL2_JITTYC_ADDITIONAL_TRANSLATION_UNIT
 static
 void rewrite_cleanup()
 {
@@ -432,9 +441,11 @@ bool init(rewriter_interface* i, RewriterCompilingJitty* this_rewriter)
 #endif
   i->rewrite_external = &rewrite;
   i->rewrite_cleanup = &rewrite_cleanup;
+  relocated_terms = i->relocated_terms;
   set_the_precompiled_rewrite_functions_in_a_lookup_table(this_rewriter);
   i->status = "rewriter loaded successfully.";
   return true;
 }
+#endif // MCRL2_JITTYC_ADDITIONAL_TRANSLATION_UNIT
 
 #endif // __REWR_JITTYC_PREAMBLE_H
@@ -0,0 +1,406 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite/machine_numbers.h
+/// \brief Evaluation of arithmetic on constants of sort Pos, Nat and Int using machine words.
+/// \details Numbers are represented by binary trees of \@c1 and \@cDub applications, such that the
+///          rewrite rules for for instance + and < require a rewrite step per bit. The functions in
+///          this file compute the result of such functions directly if all arguments are constants
+///          that fit in a machine word. In all other cases, for instance when an argument contains a
+///          variable or is too large, the rewrite rules are used as before.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_MACHINE_NUMBERS_H
+#define MCRL2_DATA_DETAIL_REWRITE_MACHINE_NUMBERS_H
+
+#include "mcrl2/data/standard.h"
+#include "mcrl2/data/standard_utility.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <map>
+
+namespace mcrl2
+{
+namespace data
+{
+namespace detail
+{
+
+/// \brief A function on numbers that can be evaluated using machine words.
+class machine_number_function
+{
+  public:
+    enum operation_type { none, plus, minus, negate, times, div, mod, exp, maximum, minimum, succ, pred, abs,
+                          conversion, less, less_equal, greater, greater_equal, equal, not_equal };
+    enum sort_type { pos_sort, nat_sort, int_sort, bool_sort };
+
+  protected:
+    operation_type m_operation = none;
+    sort_type m_codomain = bool_sort;
+
+    // Only constants with a value below 2^62 are converted, such that sums and differences do not overflow.
+    static constexpr std::size_t maximum_number_of_bits = 62;
+
+    static bool positive_value(const data_expression& e, std::int64_t& value)
+    {
+      std::uint64_t result = 0;
+      std::size_t bit = 0;
+      const data_expression* n = &e;
+      while (sort_pos::is_cdub_application(*n))
+      {
+        if (bit + 1 >= maximum_number_of_bits)
+        {
+          return false;
+        }
+        const data_expression& b = sort_pos::left(*n);
+        if (sort_bool::is_true_function_symbol(b))
+        {
+          result |= std::uint64_t(1) << bit;
+        }
+        else if (!sort_bool::is_false_function_symbol(b))
+        {
+          return false;
+        }
+        ++bit;
+        n = &sort_pos::right(*n);
+      }
+
+      if (!sort_pos::is_c1_function_symbol(*n))
+      {
+        return false;
+      }
+      value = static_cast<std::int64_t>(result | (std::uint64_t(1) << bit));
+      return true;
+    }
+
+    /// \brief Determines the value of a constant of sort Pos, Nat or Int.
+    static bool value(const data_expression& e, std::int64_t& result)
+    {
+      if (sort_nat::is_c0_function_symbol(e))
+      {
+        result = 0;
+        return true;
+      }
+      if (sort_nat::is_cnat_application(e))
+      {
+        return positive_value(sort_nat::arg(e), result);
+      }
+      if (sort_int::is_cint_application(e))
+      {
+        return value(sort_int::arg(e), result);
+      }
+      if (sort_int::is_cneg_application(e))
+      {
+        if (positive_value(sort_int::arg(e), result))
+        {
+          result = -result;
+          return true;
+        }
+        return false;
+      }
+      return positive_value(e, result);
+    }
+
+    static data_expression positive_constant(std::uint64_t n)
+    {
+      assert(n > 0);
+      std::size_t bit = std::numeric_limits<std::uint64_t>::digits - 1;
+      while ((n >> bit) == 0)
+      {
+        --bit;
+      }
+
+      data_expression result = sort_pos::c1();
+      while (bit-- > 0)
+      {
+        result = sort_pos::cdub(sort_bool::bool_(((n >> bit) & 1) != 0), result);
+      }
+      return result;
+    }
+
+    static data_expression natural_constant(std::uint64_t n)
+    {
+      if (n == 0)
+      {
+        return sort_nat::c0();
+      }
+      return sort_nat::cnat(positive_constant(n));
+    }
+
+    // Sets result to n times m, and returns false if this does not fit in a machine word.
+    static bool multiply(std::int64_t n, std::int64_t m, std::int64_t& result)
+    {
+      if (n != 0 && std::abs(m) > std::numeric_limits<std::int64_t>::max() / std::abs(n))
+      {
+        return false;
+      }
+      result = n * m;
+      return true;
+    }
+
+    static std::int64_t floor_div(std::int64_t n, std::int64_t m)
+    {
+      assert(m > 0);
+      std::int64_t result = n / m;
+      if (n % m < 0)
+      {
+        --result;
+      }
+      return result;
+    }
+
+    /// \brief Sets result to the constant of the codomain with value n, if it exists.
+    bool make_constant(data_expression& result, std::int64_t n) const
+    {
+      switch (m_codomain)
+      {
+        case pos_sort:
+          if (n < 1)
+          {
+            return false;
+          }
+          result = positive_constant(static_cast<std::uint64_t>(n));
+          return true;
+        case nat_sort:
+          if (n < 0)
+          {
+            return false;
+          }
+          result = natural_constant(static_cast<std::uint64_t>(n));
+          return true;
+        case int_sort:
+          if (n < 0)
+          {
+            result = sort_int::cneg(positive_constant(static_cast<std::uint64_t>(-n)));
+          }
+          else
+          {
+            result = sort_int::cint(natural_constant(static_cast<std::uint64_t>(n)));
+          }
+          return true;
+        default:
+          return false;
+      }
+    }
+
+    static bool number_sort(const sort_expression& s, sort_type& result)
+    {
+      if (s == sort_pos::pos())
+      {
+        result = pos_sort;
+      }
+      else if (s == sort_nat::nat())
+      {
+        result = nat_sort;
+      }
+      else if (s == sort_int::int_())
+      {
+        result = int_sort;
+      }
+      else if (s == sort_bool::bool_())
+      {
+        result = bool_sort;
+      }
+      else
+      {
+        return false;
+      }
+      return true;
+    }
+
+    static operation_type operation(const std::string& name, std::size_t arity)
+    {
+      static const std::map<std::string, operation_type> binary_operations = {
+        { "+", plus }, { "-", minus }, { "*", times }, { "div", div }, { "mod", mod }, { "exp", exp },
+        { "max", maximum }, { "min", minimum }, { "<", less }, { "<=", less_equal }, { ">", greater },
+        { ">=", greater_equal }, { "==", equal }, { "!=", not_equal } };
+      static const std::map<std::string, operation_type> unary_operations = {
+        { "-", negate }, { "succ", succ }, { "pred", pred }, { "abs", abs }, { "Pos2Nat", conversion },
+        { "Nat2Pos", conversion }, { "Pos2Int", conversion }, { "Int2Pos", conversion }, { "Nat2Int", conversion },
+        { "Int2Nat", conversion } };
+
+      const std::map<std::string, operation_type>& operations = (arity == 1 ? unary_operations : binary_operations);
+      auto i = operations.find(name);
+      return (arity > 2 || i == operations.end()) ? none : i->second;
+    }
+
+    // Determines the operation of a function symbol of Pos, Nat or Int, or none if it has no
+    // machine word implementation. Auxiliary functions such as @cDub and @divmod are not included.
+    static machine_number_function classify(const function_symbol& f)
+    {
+      machine_number_function result;
+      if (!is_function_sort(f.sort()))
+      {
+        return result;
+      }
+
+      const function_sort& s = atermpp::down_cast<function_sort>(f.sort());
+      sort_type argument_sort;
+      for (const sort_expression& argument: s.domain())
+      {
+        if (!number_sort(argument, argument_sort) || argument_sort == bool_sort)
+        {
+          return result;
+        }
+      }
+      if (!number_sort(s.codomain(), result.m_codomain))
+      {
+        return result;
+      }
+
+      result.m_operation = operation(std::string(f.name()), s.domain().size());
+      // The comparisons are the last operations, and they are the only ones with a boolean result.
+      bool is_comparison = result.m_operation >= less;
+      if ((result.m_codomain == bool_sort) != is_comparison)
+      {
+        result.m_operation = none;
+      }
+      return result;
+    }
+
+  public:
+    machine_number_function() = default;
+
+    /// \brief Constructor used in the code generated by the compiling rewriter.
+    machine_number_function(operation_type operation, sort_type codomain)
+      : m_operation(operation),
+        m_codomain(codomain)
+    {}
+
+    /// \brief Determines the machine word implementation of the function symbol f, if it has one.
+    explicit machine_number_function(const function_symbol& f)
+    {
+      // The function symbols of the standard numbers and their comparisons are classified once.
+      static const std::map<function_symbol, machine_number_function> functions = []()
+      {
+        std::map<function_symbol, machine_number_function> result;
+        function_symbol_vector candidates = sort_pos::pos_generate_functions_code();
+        function_symbol_vector nat_functions = sort_nat::nat_generate_functions_code();
+        function_symbol_vector int_functions = sort_int::int_generate_functions_code();
+        candidates.insert(candidates.end(), nat_functions.begin(), nat_functions.end());
+        candidates.insert(candidates.end(), int_functions.begin(), int_functions.end());
+        for (const sort_expression& s: { sort_pos::pos(), sort_nat::nat(), sort_int::int_() })
+        {
+          candidates.insert(candidates.end(), { data::less(s), data::less_equal(s), data::greater(s), data::greater_equal(s), data::equal_to(s), data::not_equal_to(s) });
+        }
+
+        for (const function_symbol& g: candidates)
+        {
+          machine_number_function h = classify(g);
+          if (h.defined())
+          {
+            result[g] = h;
+          }
+        }
+        return result;
+      }();
+
+      auto i = functions.find(f);
+      if (i != functions.end())
+      {
+        *this = i->second;
+      }
+    }
+
+    /// \returns True iff this function can be evaluated using machine words.
+    bool defined() const
+    {
+      return m_operation != none;
+    }
+
+    operation_type operation() const
+    {
+      return m_operation;
+    }
+
+    sort_type codomain() const
+    {
+      return m_codomain;
+    }
+
+    /// \brief Evaluates this unary function on the normal form x.
+    /// \returns False if x is not a constant that fits in a machine word, or the result does not exist.
+    bool apply(data_expression& result, const data_expression& x) const
+    {
+      std::int64_t n;
+      if (!value(x, n))
+      {
+        return false;
+      }
+
+      switch (m_operation)
+      {
+        case negate: return make_constant(result, -n);
+        case succ: return make_constant(result, n + 1);
+        case pred: return make_constant(result, n - 1);
+        case abs: return make_constant(result, std::abs(n));
+        case conversion: return make_constant(result, n);
+        default: return false;
+      }
+    }
+
+    /// \brief Evaluates this binary function on the normal forms x and y.
+    /// \returns False if x or y is not a constant that fits in a machine word, or the result does not fit.
+    bool apply(data_expression& result, const data_expression& x, const data_expression& y) const
+    {
+      std::int64_t n;
+      std::int64_t m;
+      if (!value(x, n) || !value(y, m))
+      {
+        return false;
+      }
+
+      std::int64_t k;
+      switch (m_operation)
+      {
+        case plus: return make_constant(result, n + m);
+        case minus: return make_constant(result, n - m);
+        case times: return multiply(n, m, k) && make_constant(result, k);
+        case div: return m > 0 && make_constant(result, floor_div(n, m));
+        case mod: return m > 0 && make_constant(result, n - m * floor_div(n, m));
+        case exp:
+        {
+          if (m < 0)
+          {
+            return false;
+          }
+          // Exponentiation by squaring, which fails as soon as an intermediate result does not fit.
+          k = 1;
+          while (m > 0)
+          {
+            if ((m & 1) != 0 && !multiply(k, n, k))
+            {
+              return false;
+            }
+            m >>= 1;
+            if (m > 0 && !multiply(n, n, n))
+            {
+              return false;
+            }
+          }
+          return make_constant(result, k);
+        }
+        case maximum: return make_constant(result, std::max(n, m));
+        case minimum: return make_constant(result, std::min(n, m));
+        case less: result = sort_bool::bool_(n < m); return true;
+        case less_equal: result = sort_bool::bool_(n <= m); return true;
+        case greater: result = sort_bool::bool_(n > m); return true;
+        case greater_equal: result = sort_bool::bool_(n >= m); return true;
+        case equal: result = sort_bool::bool_(n == m); return true;
+        case not_equal: result = sort_bool::bool_(n != m); return true;
+        default: return false;
+      }
+    }
+};
+
+} // namespace detail
+} // namespace data
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_MACHINE_NUMBERS_H
@@ -12,6 +12,7 @@
 #define MCRL2_DATA_DETAIL_REWRITE_STRATEGY_RULE_H
 
 #include "mcrl2/data/data_equation.h"
+#include "mcrl2/data/detail/rewrite/machine_numbers.h"
 
 namespace mcrl2
 {
@@ -24,13 +25,14 @@ namespace detail
 class strategy_rule 
 {
   protected:
-    // Only one of the fields rewrite_rule, rewrite_index or cpp_function will be used
-    // at any given time. As this hardly requires a lot of memory, we do not optimise
+    // Only one of the fields rewrite_rule, rewrite_index, cpp_function or machine_number_function
+    // will be used at any given time. As this hardly requires a lot of memory, we do not optimise
     // this using for instance a union type. 
-    enum { data_equation_type, rewrite_index_type, cpp_function_type } m_strategy_element_type;
+    enum { data_equation_type, rewrite_index_type, cpp_function_type, machine_number_function_type } m_strategy_element_type;
     data_equation m_rewrite_rule;
     size_t m_rewrite_index;
     std::function<data_expression(const data_expression&)> m_cpp_function;
+    machine_number_function m_machine_number_function;
 
   public:
     strategy_rule(const std::size_t n)
@@ -48,6 +50,11 @@ class strategy_rule
         m_rewrite_rule(eq)
     {}
 
+    strategy_rule(const machine_number_function& f)
+      : m_strategy_element_type(machine_number_function_type),
+        m_machine_number_function(f)
+    {}
+
     bool is_rewrite_index() const
     {
       return m_strategy_element_type==rewrite_index_type;
@@ -59,6 +66,12 @@ class strategy_rule
       return m_strategy_element_type==cpp_function_type;
     }
 
+    /// \brief True iff this rule evaluates a function on numbers using machine words, if its arguments allow it.
+    bool is_machine_number_function() const
+    {
+      return m_strategy_element_type==machine_number_function_type;
+    }
+
     bool is_equation() const
     {
       return m_strategy_element_type==data_equation_type;
@@ -82,6 +95,12 @@ class strategy_rule
       assert(is_cpp_code());
       return m_cpp_function;
     }
+
+    const machine_number_function& number_function() const
+    {
+      assert(is_machine_number_function());
+      return m_machine_number_function;
+    }
 };
 
 /// A strategy is a list of rules and the number of variables that occur in it.
@@ -12,6 +12,7 @@
 #ifndef MCRL2_DATA_DETAIL_REWRITE_STATISTICS_H
 #define MCRL2_DATA_DETAIL_REWRITE_STATISTICS_H
 
+#include "mcrl2/utilities/cache_metric.h"
 #include "mcrl2/utilities/logger.h"
 
 namespace mcrl2
@@ -54,6 +55,13 @@ void increment_rewrite_count()
   }
 }
 
+/// \brief Displays the number of hits and misses in the cache with normal forms of closed terms.
+inline
+void display_normal_form_cache_statistics(const utilities::cache_metric& metric)
+{
+  mCRL2log(log::verbose) << "normal form cache: " << metric.message() << std::endl;
+}
+
 } // namespace detail
 
 } // namespace data
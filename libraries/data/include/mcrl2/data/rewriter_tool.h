@@ -13,6 +13,7 @@
 #define MCRL2_DATA_REWRITER_TOOL_H
 
 #include "mcrl2/data/detail/enumerator_iteration_limit.h"
+#include "mcrl2/data/detail/normal_form_cache_size.h"
 #include "mcrl2/data/rewriter.h"
 #include "mcrl2/utilities/command_line_interface.h"
 
@@ -65,6 +66,12 @@ class rewriter_tool: public Tool
         'Q'
       );
 
+      desc.add_option(
+        "rewrite-cache", 
+        utilities::make_mandatory_argument("NUM"),
+        "cache the normal forms of at most NUM closed terms in the jitty rewriter. (Default NUM=0, no caching)."
+      );
+
     }
 
     /// \brief Add options to an interface description. Also includes
@@ -89,6 +96,11 @@ class rewriter_tool: public Tool
         std::size_t qlimit = parser.option_argument_as< std::size_t >("qlimit");
         data::detail::set_enumerator_iteration_limit(qlimit == 0 ? std::numeric_limits<std::size_t>::max() : qlimit);
       }
+
+      if(parser.options.count("rewrite-cache"))
+      {
+        data::detail::set_normal_form_cache_size(parser.option_argument_as< std::size_t >("rewrite-cache"));
+      }
     }
 
   public:
@@ -11,16 +11,14 @@
 
 #include "mcrl2/data/detail/rewrite/jitty.h"
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
+#include "mcrl2/data/detail/normal_form_cache_size.h"
+#include "mcrl2/data/detail/rewrite_statistics.h"
 
 #include <boost/config.hpp>
 
 #include "mcrl2/data/substitutions/mutable_map_substitution.h"
 #include "mcrl2/data/replace.h"
 
-#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
-#include "mcrl2/data/detail/rewrite_statistics.h"
-#endif
-
 using namespace mcrl2::log;
 using namespace mcrl2::core;
 using namespace mcrl2::core::detail;
@@ -165,7 +163,9 @@ RewriterJitty::RewriterJitty(
         this_term_is_in_normal_form_symbol(
                          std::string("Rewritten@@term"),
                          function_sort({ untyped_sort() },untyped_sort())),
-        rewriting_in_progress(false)
+        rewriting_in_progress(false),
+        m_normal_form_cache_size(get_normal_form_cache_size()),
+        m_normal_form_cache(m_normal_form_cache_size)
 {
   thread_initialise();
   for (const data_equation& eq: data_spec.equations())
@@ -200,6 +200,10 @@ RewriterJitty::RewriterJitty(
 
 RewriterJitty::~RewriterJitty()
 {
+  if (m_normal_form_cache_size>0)
+  {
+    display_normal_form_cache_statistics(m_normal_form_cache_metric);
+  }
 }
 
 void RewriterJitty::subst_values(
@@ -454,6 +458,11 @@ void RewriterJitty::rewrite_aux(
   
     if (is_function_symbol(head) && head!=this_term_is_in_normal_form())
     {
+      if (m_normal_form_cache_size>0)
+      {
+        rewrite_aux_closed_term(result, atermpp::down_cast<function_symbol>(head),terma,sigma);
+        return;
+      }
       // return rewrite_aux_function_symbol(atermpp::down_cast<function_symbol>(head),term,sigma);
       rewrite_aux_function_symbol(result, atermpp::down_cast<function_symbol>(head),terma,sigma);
       return;
@@ -557,6 +566,57 @@ void RewriterJitty::rewrite_aux(
   }
 }
 
+// Returns true if t does not contain variables. Terms with binders are conservatively not considered to be closed.
+bool RewriterJitty::is_closed(const data_expression& t)
+{
+  if (is_function_symbol(t))
+  {
+    return true;
+  }
+  if (is_application(t))
+  {
+    const application& ta=atermpp::down_cast<application>(t);
+    return is_closed(ta.head()) && std::all_of(ta.begin(), ta.end(), [this](const data_expression& u){ return is_closed(u); });
+  }
+  return false;
+}
+
+/// \brief Rewrite a term of the shape f(t1,...,tn), using the cache with normal forms if the term is closed.
+/// \details The normal form of a closed term does not depend on sigma. Subterms of a closed term are closed as well,
+///          except for the bodies of binders, which are rewritten via rewrite. So, once it is established that
+///          a term is closed, this does not need to be checked again for the terms met while rewriting it.
+void RewriterJitty::rewrite_aux_closed_term(
+                      data_expression& result,
+                      const function_symbol& op,
+                      const application& term,
+                      substitution_type& sigma)
+{
+  auto i = m_normal_form_cache.find(term);
+  if (i != m_normal_form_cache.end())
+  {
+    m_normal_form_cache_metric.hit();
+    result.assign(i->second,
+                  this->m_busy_flag,
+                  this->m_forbidden_flag,
+                  this->m_lock_depth);
+    return;
+  }
+
+  if (!m_rewriting_closed_term && !is_closed(term))
+  {
+    rewrite_aux_function_symbol(result, op, term, sigma);
+    return;
+  }
+
+  m_normal_form_cache_metric.miss();
+  const data_expression closed_term = term; // term may refer to the rewrite stack, which can be changed.
+  const bool rewriting_closed_term = m_rewriting_closed_term;
+  m_rewriting_closed_term = true;
+  rewrite_aux_function_symbol(result, op, term, sigma);
+  m_rewriting_closed_term = rewriting_closed_term;
+  m_normal_form_cache.emplace(closed_term, result);
+}
+
 void RewriterJitty::rewrite_aux_function_symbol(
                       data_expression& result, 
                       const function_symbol& op,
@@ -609,6 +669,18 @@ void RewriterJitty::rewrite_aux_function_symbol(
           break;
         }
       }
+      else if (rule.is_machine_number_function())
+      {
+        // All arguments have been rewritten. If they are constants that fit in a machine word,
+        // the result is calculated directly. Otherwise the rewrite rules that follow are applied.
+        if (term.head()==op &&
+            (arity==1?rule.number_function().apply(result, m_rewrite_stack.element(0,arity+1)):
+                      rule.number_function().apply(result, m_rewrite_stack.element(0,arity+1), m_rewrite_stack.element(1,arity+1))))
+        {
+          m_rewrite_stack.decrease(arity+1);
+          return;
+        }
+      }
       else if (rule.is_cpp_code())
       {
         // Here it is assumed that precompiled code only works on the exact right number of arguments and
@@ -869,12 +941,17 @@ void RewriterJitty::rewrite(
 #endif
   if (rewriting_in_progress)
   {
+    // This term can be the body of a binder in a closed term, in which case it can contain the bound variables.
+    const bool rewriting_closed_term = m_rewriting_closed_term;
+    m_rewriting_closed_term = false;
     rewrite_aux(result, term, sigma);
+    m_rewriting_closed_term = rewriting_closed_term;
   }
   else
   {
     assert(m_rewrite_stack.stack_size()==0);
     rewriting_in_progress=true;
+    m_rewriting_closed_term=false;
     try
     {
       rewrite_aux(result, term, sigma);
@@ -14,14 +14,20 @@
 
 #define NAME "rewr_jittyc"
 
+#include <dirent.h>
+#include <iomanip>
+#include <thread>
 #include <unistd.h>
+#include <utime.h>
 #include <sys/stat.h>
 #include "mcrl2/utilities/basename.h"
 #include "mcrl2/utilities/stopwatch.h"
 #include "mcrl2/atermpp/algorithm.h"
+#include "mcrl2/atermpp/aterm_io_binary.h"
 #include "mcrl2/atermpp/detail/aterm_list_implementation.h"
 #include "mcrl2/data/detail/rewrite/jittyc.h"
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
+#include "mcrl2/data/detail/io.h"
 #include "mcrl2/data/replace.h"
 
 #ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
@@ -1920,7 +1926,7 @@ class RewriterCompilingJitty::ImplementTree
              std::map<variable,std::string>& type_of_code_variables)
   {
     bool reset_current_data_parameters=false;
-    const void* func = (void*)(atermpp::detail::address(tree.function()));
+    const std::string func = "uint_address(" + m_rewriter.m_nf_cache->insert(tree.function()) + ")";
     m_stream << m_padding;
     brackets.bracket_nesting_level++;
     if (level == 0)
@@ -2298,6 +2304,67 @@ public:
     }
   }
 
+  // Rewrite argument arg to normal form, unless this has been done before. The normal form is stored in the
+  // variable arg<arg>, which is added to the parameters and arguments of auxiliary functions.
+  void implement_rewrite_argument(
+             std::ostream& m_stream,
+             std::size_t arg,
+             bracket_level_data& brackets,
+             bool& added_new_parameters_in_brackets)
+  {
+    if (!m_used[arg])
+    {
+      // m_stream << m_padding << "const data_expression& arg" << arg << " = local_rewrite(arg_not_nf" << arg << ");\n"; 
+      /* m_stream << m_padding << "data_expression& arg" << arg << " = this_rewriter->m_rewrite_stack.new_stack_position();\n"
+               << m_padding << "local_rewrite(arg" << arg << ", arg_not_nf" << arg << ");\n"; */
+   
+      m_stream << m_padding << "data_expression& arg" << arg 
+               << "(std::is_convertible<DATA_EXPR" << arg << ", const data_expression&>::value?(const_cast<data_expression&>(reinterpret_cast<const data_expression&>(arg_not_nf" << arg << "))):this_rewriter->m_rewrite_stack.new_stack_position());\n"
+               << m_padding << "if constexpr (!std::is_convertible<DATA_EXPR" << arg << ", const data_expression&>::value)\n"
+               << m_padding << "{\n"
+               << m_padding << "  local_rewrite(arg" << arg << ", arg_not_nf" << arg << ");\n"
+               << m_padding << "}\n";
+      m_used[arg] = true;
+      if (!added_new_parameters_in_brackets)
+      {
+        added_new_parameters_in_brackets=true;
+        brackets.current_data_parameters.push(brackets.current_data_parameters.top()); 
+        brackets.current_data_arguments.push(brackets.current_data_arguments.top()); 
+      }
+      const std::string& parameters=brackets.current_data_parameters.top();
+      brackets.current_data_parameters.top()=parameters + (parameters.empty()?"":", ") + "const data_expression& arg" + std::to_string(arg);
+      const std::string arguments = brackets.current_data_arguments.top();
+      brackets.current_data_arguments.top()=arguments + (arguments.empty()?"":", ") + "arg" + std::to_string(arg);
+    }
+  }
+
+  // For functions on numbers, all arguments are rewritten first, after which the result is calculated
+  // using machine words if the arguments are sufficiently small constants. Otherwise the match tree
+  // that follows applies the rewrite rules to the rewritten arguments.
+  void implement_machine_number_function(
+             std::ostream& m_stream,
+             const machine_number_function& native,
+             std::size_t arity,
+             bracket_level_data& brackets,
+             bool& added_new_parameters_in_brackets)
+  {
+    for (std::size_t i = 0; i < arity; ++i)
+    {
+      implement_rewrite_argument(m_stream, i, brackets, added_new_parameters_in_brackets);
+    }
+    m_stream << m_padding << "if (machine_number_function(machine_number_function::operation_type(" << native.operation() << "), "
+                          << "machine_number_function::sort_type(" << native.codomain() << ")).apply(result";
+    for (std::size_t i = 0; i < arity; ++i)
+    {
+      m_stream << ", arg" << i;
+    }
+    m_stream << "))\n"
+             << m_padding << "{\n"
+             << m_padding << "  this_rewriter->m_rewrite_stack.reset_stack_size(old_stack_size);\n"
+             << m_padding << "  return;\n"
+             << m_padding << "}\n";
+  }
+
   void implement_strategy(
              std::ostream& m_stream, 
              match_tree_list strat, 
@@ -2318,36 +2385,18 @@ public:
     m_used=nfs_array(arity); // This vector maintains which arguments are in normal form.
     // m_nnfvars=variable_or_number_list();
     std::map<variable,std::string> type_of_code_variables;
+    const machine_number_function native(opid);
+    if (native.defined() && arity==get_direct_arity(opid))
+    {
+      implement_machine_number_function(m_stream, native, arity, brackets, added_new_parameters_in_brackets);
+    }
     while (!strat.empty())
     {
       m_stream << m_padding << "// " << strat.front() <<  "\n";
       if (strat.front().isA())
       {
         std::size_t arg = match_tree_A(strat.front()).variable_index();
-        if (!m_used[arg])
-        {
-          // m_stream << m_padding << "const data_expression& arg" << arg << " = local_rewrite(arg_not_nf" << arg << ");\n"; 
-          /* m_stream << m_padding << "data_expression& arg" << arg << " = this_rewriter->m_rewrite_stack.new_stack_position();\n"
-                   << m_padding << "local_rewrite(arg" << arg << ", arg_not_nf" << arg << ");\n"; */
-       
-          m_stream << m_padding << "data_expression& arg" << arg 
-                   << "(std::is_convertible<DATA_EXPR" << arg << ", const data_expression&>::value?(const_cast<data_expression&>(reinterpret_cast<const data_expression&>(arg_not_nf" << arg << "))):this_rewriter->m_rewrite_stack.new_stack_position());\n"
-                   << m_padding << "if constexpr (!std::is_convertible<DATA_EXPR" << arg << ", const data_expression&>::value)\n"
-                   << m_padding << "{\n"
-                   << m_padding << "  local_rewrite(arg" << arg << ", arg_not_nf" << arg << ");\n"
-                   << m_padding << "}\n";
-          m_used[arg] = true;
-          if (!added_new_parameters_in_brackets)
-          {
-            added_new_parameters_in_brackets=true;
-            brackets.current_data_parameters.push(brackets.current_data_parameters.top()); 
-            brackets.current_data_arguments.push(brackets.current_data_arguments.top()); 
-          }
-          const std::string& parameters=brackets.current_data_parameters.top();
-          brackets.current_data_parameters.top()=parameters + (parameters.empty()?"":", ") + "const data_expression& arg" + std::to_string(arg);
-          const std::string arguments = brackets.current_data_arguments.top();
-          brackets.current_data_arguments.top()=arguments + (arguments.empty()?"":", ") + "arg" + std::to_string(arg);
-        }
+        implement_rewrite_argument(m_stream, arg, brackets, added_new_parameters_in_brackets);
         m_stream << m_padding << "// Considering argument " << arg << "\n";
       }
       else
@@ -2546,11 +2595,8 @@ public:
     }
     else
     {
-      std::stringstream ss;
-      ss << "this_rewriter->normal_forms_for_constants[" 
-         << atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(opid) 
-         << "]";
-      rewr_function_finish_term(m_stream, arity, ss.str(), down_cast<function_sort>(opid.sort()));
+      RewriterCompilingJitty::substitution_type sigma;
+      rewr_function_finish_term(m_stream, arity, m_rewriter.m_nf_cache->insert(m_rewriter.jitty_rewriter(opid,sigma)), down_cast<function_sort>(opid.sort()));
     } 
   }
 
@@ -2785,6 +2831,188 @@ static std::string generate_cpp_filename(std::size_t unique)
   return filename.str();
 }
 
+///
+/// \brief A directory with compiled rewriters that are reused by later runs of the tools.
+/// \details The directory is given by the environment variable MCRL2_COMPILEREWRITER_CACHE. If
+///          it is not set, compiled rewriters are not cached. A compiled rewriter is stored under
+///          a hash of everything that determines the generated code. The environment variable
+///          MCRL2_COMPILEREWRITER_CACHE_SIZE gives the maximal size of the cache in megabytes,
+///          which is 1024 by default. If the cache becomes larger, the least recently used
+///          rewriters are removed. The number of hits and misses is kept in the file statistics.
+///
+class compiled_rewriter_cache
+{
+  protected:
+    std::string m_directory;
+    std::size_t m_maximum_size = std::size_t(1024) << 20;
+
+    static bool copy_file(const std::string& source, const std::string& destination)
+    {
+      std::ifstream in(source, std::ios::binary);
+      std::ofstream out(destination, std::ios::binary);
+      out << in.rdbuf();
+      return in.good() && out.good();
+    }
+
+    // Files are written under a temporary name first, such that other processes never see a partial file.
+    std::string temporary_filename(const std::string& filename) const
+    {
+      return filename + "." + std::to_string(getpid()) + ".tmp";
+    }
+
+    // Increases the number of hits or misses, and returns a message with both numbers.
+    std::string update_statistics(bool hit) const
+    {
+      const std::string filename = m_directory + "statistics";
+      std::size_t hits = 0;
+      std::size_t misses = 0;
+      std::ifstream(filename) >> hits >> misses;
+      (hit ? hits : misses)++;
+      {
+        std::ofstream out(temporary_filename(filename));
+        out << hits << " " << misses << "\n";
+      }
+      std::rename(temporary_filename(filename).c_str(), filename.c_str());
+      return std::to_string(hits) + " hits and " + std::to_string(misses) + " misses in the cache";
+    }
+
+    // Removes the least recently used rewriters until the cache is not larger than the maximal size.
+    void remove_old_rewriters(const std::string& key) const
+    {
+      std::vector<std::pair<time_t, std::string>> rewriters;
+      std::size_t size = 0;
+      if (DIR* directory = opendir(m_directory.c_str()))
+      {
+        while (const dirent* entry = readdir(directory))
+        {
+          const std::string name = entry->d_name;
+          const std::string suffix = ".bin";
+          struct stat status;
+          if (name.compare(0, 7, "jittyc_") == 0 &&
+              name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0 &&
+              stat((m_directory + name).c_str(), &status) == 0)
+          {
+            const std::string entry_key = name.substr(7, name.size() - 7 - suffix.size());
+            const time_t last_used = status.st_mtime;
+            size += status.st_size;
+            if (stat(relocation_filename(entry_key).c_str(), &status) == 0)
+            {
+              size += status.st_size;
+            }
+            if (entry_key != key)
+            {
+              rewriters.emplace_back(last_used, entry_key);
+            }
+          }
+        }
+        closedir(directory);
+      }
+
+      std::sort(rewriters.begin(), rewriters.end());
+      for (const std::pair<time_t, std::string>& rewriter: rewriters)
+      {
+        if (size <= m_maximum_size)
+        {
+          break;
+        }
+        struct stat status;
+        for (const std::string& filename: { library_filename(rewriter.second), relocation_filename(rewriter.second) })
+        {
+          if (stat(filename.c_str(), &status) == 0 && std::remove(filename.c_str()) == 0)
+          {
+            size -= std::min<std::size_t>(size, status.st_size);
+          }
+        }
+        mCRL2log(debug) << "removed compiled rewriter " << rewriter.second << " from the cache." << std::endl;
+      }
+    }
+
+  public:
+    compiled_rewriter_cache()
+    {
+      const char* env_dir = std::getenv("MCRL2_COMPILEREWRITER_CACHE");
+      if (env_dir != nullptr && *env_dir != 0)
+      {
+        m_directory = env_dir;
+        if (*m_directory.rbegin() != '/')
+        {
+          m_directory.append("/");
+        }
+        mkdir(m_directory.c_str(), 0755);
+      }
+      const char* env_size = std::getenv("MCRL2_COMPILEREWRITER_CACHE_SIZE");
+      if (env_size != nullptr)
+      {
+        m_maximum_size = std::strtoull(env_size, nullptr, 10) << 20;
+      }
+    }
+
+    bool enabled() const
+    {
+      return !m_directory.empty();
+    }
+
+    /// \brief A 64 bit FNV-1a hash of the description of a rewriter, which is used as key in the cache.
+    static std::string key(const std::string& description)
+    {
+      std::uint64_t hash = 14695981039346656037ULL;
+      for (const char c: description)
+      {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+      }
+      std::ostringstream result;
+      result << std::hex << std::setw(16) << std::setfill('0') << hash;
+      return result.str();
+    }
+
+    std::string library_filename(const std::string& key) const
+    {
+      return m_directory + "jittyc_" + key + ".bin";
+    }
+
+    std::string relocation_filename(const std::string& key) const
+    {
+      return m_directory + "jittyc_" + key + ".terms";
+    }
+
+    /// \brief Copies the compiled rewriter with the given key to filename, if it is in the cache.
+    bool find(const std::string& key, const std::string& filename) const
+    {
+      if (!mcrl2::utilities::file_exists(library_filename(key)) || !mcrl2::utilities::file_exists(relocation_filename(key)))
+      {
+        return false;
+      }
+      // The library is loaded from a copy, such that a rewriter that is loaded twice does not share its global variables.
+      return copy_file(library_filename(key), filename);
+    }
+
+    /// \brief Marks the rewriter with the given key as recently used.
+    /// \return A message with the number of hits and misses of the cache.
+    std::string hit(const std::string& key) const
+    {
+      utime(library_filename(key).c_str(), nullptr);
+      return update_statistics(true);
+    }
+
+    /// \brief Stores the compiled rewriter in library in the cache. 
+    /// \param save_relocation_information A function that writes the terms used by the library to a file.
+    /// \return A message with the number of hits and misses of the cache.
+    std::string store(const std::string& key, const std::string& library, const std::function<void(const std::string&)>& save_relocation_information) const
+    {
+      save_relocation_information(temporary_filename(relocation_filename(key)));
+      if (!copy_file(library, temporary_filename(library_filename(key))) ||
+          std::rename(temporary_filename(relocation_filename(key)).c_str(), relocation_filename(key).c_str()) != 0 ||
+          std::rename(temporary_filename(library_filename(key)).c_str(), library_filename(key).c_str()) != 0)
+      {
+        std::remove(temporary_filename(relocation_filename(key)).c_str());
+        std::remove(temporary_filename(library_filename(key)).c_str());
+        throw mcrl2::runtime_error("could not store the compiled rewriter in " + m_directory + ".");
+      }
+      remove_old_rewriters(key);
+      return update_statistics(false);
+    }
+};
+
 ///
 /// \brief filter_function_symbols selects the function symbols from source for which filter
 ///        returns true, and copies them to dest.
@@ -2804,13 +3032,28 @@ void filter_function_symbols(const function_symbol_vector& source, function_symb
   }
 }
 
-void RewriterCompilingJitty::generate_code(const std::string& filename)
+/// \brief The number of translation units in which the generated rewriter is split.
+/// \details The translation units are compiled concurrently by the compile script. By default one
+///          translation unit per hardware thread is generated, which can be changed with the
+///          environment variable MCRL2_COMPILEREWRITER_JOBS. Every translation unit contains at
+///          least a minimal number of rewrite functions, as small translation units do not pay off.
+/// \param number_of_functions The number of rewrite functions that can be distributed.
+static std::size_t number_of_translation_units(std::size_t number_of_functions)
 {
-  std::ofstream cpp_file(filename);
+  const std::size_t minimal_number_of_functions = 32;
+  std::size_t result = std::thread::hardware_concurrency();
+  const char* env_jobs = std::getenv("MCRL2_COMPILEREWRITER_JOBS");
+  if (env_jobs != nullptr)
+  {
+    result = std::strtoul(env_jobs, nullptr, 10);
+  }
+  return std::max<std::size_t>(1, std::min(result, number_of_functions / minimal_number_of_functions));
+}
+
+std::vector<std::string> RewriterCompilingJitty::generate_code(const std::string& filename)
+{
+  std::stringstream shared_code;
   std::stringstream rewr_code;
-  // arity_bound is one larger than the maximal arity. 
-  arity_bound = 1+std::max(calc_max_arity(m_data_specification_for_enumeration.constructors()),
-                           calc_max_arity(m_data_specification_for_enumeration.mappings()));
 
   // - Store all used function symbols in a vector
   std::vector<function_symbol> function_symbols; 
@@ -2824,16 +3067,9 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
   // jittycpreamble.h.
   ImplementTree code_generator(*this, function_symbols);
 
-  index_bound = atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::max_index() + 1;
-
-  functions_when_arguments_are_not_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
-  functions_when_arguments_are_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
-
-  cpp_file << "#define INDEX_BOUND__ " << index_bound << "// These values are not used anymore.\n"
-              "#define ARITY_BOUND__ " << arity_bound << "// These values are not used anymore.\n";
-  cpp_file << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
+  initialise_function_tables();
 
-  cpp_file << "namespace {\n"
+  shared_code << "namespace {\n"
                "// Anonymous namespace so the compiler uses internal linkage for the generated\n"
                "// rewrite code.\n"
                "\n"
@@ -2874,56 +3110,216 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
   rewr_code << "};\n"
                "} // namespace\n";
 
-  code_generator.generate_delayed_application_functions(cpp_file);
+  code_generator.generate_delayed_application_functions(shared_code);
 
-  cpp_file << rewr_code.str();
+  shared_code << rewr_code.str();
 
-  cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n"
-              "{\n";
-  cpp_file << "  assert(&this_rewriter->functions_when_arguments_are_not_in_normal_form == (void *)" << &functions_when_arguments_are_not_in_normal_form << ");  // Check that this table matches the one rewriter is actually using.\n";
-  cpp_file << "  assert(&this_rewriter->functions_when_arguments_are_in_normal_form == (void *)" << &functions_when_arguments_are_in_normal_form << ");  // Check that this table matches the one rewriter is actually using.\n";
-  cpp_file << "  for(rewriter_function& f: this_rewriter->functions_when_arguments_are_not_in_normal_form)\n"
-           << "  {\n"
-           << "    f = nullptr;\n"
-           << "  }\n";
-  cpp_file << "  for(rewriter_function& f: this_rewriter->functions_when_arguments_are_in_normal_form)\n"
-           << "  {\n"
-           << "    f = nullptr;\n"
-           << "  }\n";
-
-  // Fill tables with the rewrite functions
-  RewriterCompilingJitty::substitution_type sigma;
-  normal_forms_for_constants.clear();
+  // The rewrite functions that are put in the lookup tables are distributed over several translation
+  // units. All rewrite functions are defined in every translation unit, but as they have internal
+  // linkage, a translation unit only instantiates and compiles the functions that are reachable
+  // from the functions that it puts in the lookup tables.
+  std::vector<const rewr_function_spec*> table_functions;
+  m_constants.clear();
   for (const rewr_function_spec& f: code_generator.implemented_rewrs())
   {
     if (!f.delayed())
     {
-      std::size_t index = atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(f.fs());
       if (f.arity()>0)
       {
-        cpp_file << "  this_rewriter->functions_when_arguments_are_not_in_normal_form[this_rewriter->arity_bound * "
-                 << index
-                 << " + " << f.arity() << "] = rewr_functions::"
-                 << f.name() << "_term;\n";
-        cpp_file << "  this_rewriter->functions_when_arguments_are_in_normal_form[this_rewriter->arity_bound * "
-                 << index
-                 << " + " << f.arity() << "] = rewr_functions::"
-                 << f.name() << "_term_arg_in_normal_form;\n";
+        table_functions.push_back(&f);
       }
       else
       { 
-        if (index>=normal_forms_for_constants.size())
-        {
-          normal_forms_for_constants.resize(index+1);
-        }
-        normal_forms_for_constants[index]=jitty_rewriter(f.fs(),sigma);
+        m_constants.push_back(f.fs());
+      }
+    }
+  }
+  set_normal_forms_for_constants();
+
+  // Function symbols that are declared together, such as those of one sort, often use each other. They are
+  // put in the same translation unit, to limit the functions that are compiled in more than one unit.
+  typedef atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2> function_symbol_index;
+  std::sort(table_functions.begin(), table_functions.end(), [](const rewr_function_spec* f, const rewr_function_spec* g)
+    {
+      return std::make_pair(function_symbol_index::index(f->fs()), f->arity()) < 
+             std::make_pair(function_symbol_index::index(g->fs()), g->arity());
+    });
+  const std::size_t number_of_units = number_of_translation_units(table_functions.size());
+  std::vector<std::string> filenames(1, filename);
+  for (std::size_t unit = 1; unit < number_of_units; ++unit)
+  {
+    filenames.push_back(filename.substr(0, filename.size() - std::string(".cpp").size()) + "_" + std::to_string(unit) + ".cpp");
+  }
+
+  for (std::size_t unit = 0; unit < number_of_units; ++unit)
+  {
+    std::ofstream cpp_file(filenames[unit]);
+    cpp_file << "#define INDEX_BOUND__ " << index_bound << "// These values are not used anymore.\n"
+                "#define ARITY_BOUND__ " << arity_bound << "// These values are not used anymore.\n";
+    if (unit > 0)
+    {
+      cpp_file << "#define MCRL2_JITTYC_ADDITIONAL_TRANSLATION_UNIT\n";
+    }
+    cpp_file << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
+    cpp_file << shared_code.str();
+
+    if (unit == 0)
+    {
+      for (std::size_t other_unit = 1; other_unit < number_of_units; ++other_unit)
+      {
+        cpp_file << "void set_the_precompiled_rewrite_functions_of_unit_" << other_unit 
+                 << "(RewriterCompilingJitty* this_rewriter, const data_expression* terms);\n";
+      }
+      cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n"
+                  "{\n";
+      cpp_file << "  assert(this_rewriter->functions_when_arguments_are_not_in_normal_form.size() == this_rewriter->arity_bound * this_rewriter->index_bound);\n";
+      cpp_file << "  assert(this_rewriter->functions_when_arguments_are_in_normal_form.size() == this_rewriter->arity_bound * this_rewriter->index_bound);\n";
+      cpp_file << "  for(rewriter_function& f: this_rewriter->functions_when_arguments_are_not_in_normal_form)\n"
+               << "  {\n"
+               << "    f = nullptr;\n"
+               << "  }\n";
+      cpp_file << "  for(rewriter_function& f: this_rewriter->functions_when_arguments_are_in_normal_form)\n"
+               << "  {\n"
+               << "    f = nullptr;\n"
+               << "  }\n";
+      for (std::size_t other_unit = 1; other_unit < number_of_units; ++other_unit)
+      {
+        cpp_file << "  set_the_precompiled_rewrite_functions_of_unit_" << other_unit << "(this_rewriter, relocated_terms);\n";
       }
     }
+    else
+    {
+      cpp_file << "void set_the_precompiled_rewrite_functions_of_unit_" << unit 
+               << "(RewriterCompilingJitty* this_rewriter, const data_expression* terms)\n"
+                  "{\n"
+                  "  relocated_terms = terms;\n";
+    }
+
+    // Fill tables with the rewrite functions. The index of a function symbol is determined when the rewriter
+    // is loaded, as it differs between processes. 
+    for (std::size_t i = unit * table_functions.size() / number_of_units; i < (unit + 1) * table_functions.size() / number_of_units; ++i)
+    {
+      const rewr_function_spec& f = *table_functions[i];
+      const std::string index = "get_index(down_cast<function_symbol>(" + m_nf_cache->insert(f.fs()) + "))";
+      cpp_file << "  this_rewriter->functions_when_arguments_are_not_in_normal_form[this_rewriter->arity_bound * "
+               << index
+               << " + " << f.arity() << "] = rewr_functions::"
+               << f.name() << "_term;\n";
+      cpp_file << "  this_rewriter->functions_when_arguments_are_in_normal_form[this_rewriter->arity_bound * "
+               << index
+               << " + " << f.arity() << "] = rewr_functions::"
+               << f.name() << "_term_arg_in_normal_form;\n";
+    }
+
+    cpp_file << "}\n";
+  }
+  return filenames;
+}
+
+void RewriterCompilingJitty::initialise_function_tables()
+{
+  // arity_bound is one larger than the maximal arity. 
+  arity_bound = 1+std::max(calc_max_arity(m_data_specification_for_enumeration.constructors()),
+                           calc_max_arity(m_data_specification_for_enumeration.mappings()));
+  index_bound = atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::max_index() + 1;
+
+  functions_when_arguments_are_not_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
+  functions_when_arguments_are_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
+}
+
+void RewriterCompilingJitty::set_normal_forms_for_constants()
+{
+  RewriterCompilingJitty::substitution_type sigma;
+  normal_forms_for_constants.clear();
+  for (const function_symbol& f: m_constants)
+  {
+    std::size_t index = atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(f);
+    if (index>=normal_forms_for_constants.size())
+    {
+      normal_forms_for_constants.resize(index+1);
+    }
+    normal_forms_for_constants[index]=jitty_rewriter(f,sigma);
   }
+}
+
+std::string RewriterCompilingJitty::compiled_rewriter_description(const std::string& compile_script)
+{
+  // The description contains everything that determines the generated code and the way it is compiled. 
+  // Indices of function symbols and variables differ between processes, and are therefore removed.
+  std::ostringstream description;
+  const char* env_cxx = std::getenv("CXX");
+  std::ifstream script(compile_script);
+  description << mcrl2::utilities::get_toolset_version() << "\n"
+              << compile_script << "\n"
+              << (env_cxx == nullptr ? "" : env_cxx) << "\n"
+              << std::string(std::istreambuf_iterator<char>(script), std::istreambuf_iterator<char>()) << "\n";
+  for (const sort_expression& s: m_data_specification_for_enumeration.sorts())
+  {
+    description << s << "\n";
+  }
+  for (const function_symbol_vector& symbols: { m_data_specification_for_enumeration.constructors(),
+                                                m_data_specification_for_enumeration.mappings() })
+  {
+    for (const function_symbol& f: symbols)
+    {
+      description << remove_index(f) << " " << data_equation_selector(f) << "\n";
+    }
+  }
+  for (const data_equation& e: rewrite_rules)
+  {
+    description << remove_index(e) << "\n";
+  }
+  return description.str();
+}
 
+void RewriterCompilingJitty::save_relocation_information(const std::string& filename)
+{
+  std::ofstream file(filename, std::ios::binary);
+  atermpp::binary_aterm_ostream stream(file);
+  stream << remove_index_impl;
+  stream << m_nf_cache->terms();
+  stream << rewriter_bound_variables;
+  stream << rewriter_binding_variable_lists;
+  stream << m_constants;
+}
 
-  cpp_file << "}\n";
-  cpp_file.close();
+bool RewriterCompilingJitty::load_relocation_information(const std::string& filename)
+{
+  std::vector<data_expression> terms;
+  std::vector<variable> bound_variables;
+  std::vector<variable_list> binding_variable_lists;
+  function_symbol_vector constants;
+  try
+  {
+    std::ifstream file(filename, std::ios::binary);
+    atermpp::binary_aterm_istream stream(file);
+    stream >> add_index_impl;
+    stream >> terms;
+    stream >> bound_variables;
+    stream >> binding_variable_lists;
+    stream >> constants;
+  }
+  catch (std::runtime_error& e)
+  {
+    mCRL2log(warning) << "Could not read " << filename << ": " << e.what() << std::endl;
+    return false;
+  }
+
+  assert(m_nf_cache->empty());
+  for (const data_expression& t: terms)
+  {
+    m_nf_cache->index(t);
+  }
+  for (const variable& v: bound_variables)
+  {
+    bound_variable_index(v);
+  }
+  for (const variable_list& vl: binding_variable_lists)
+  {
+    binding_variable_list_index(vl);
+  }
+  m_constants = constants;
+  return true;
 }
 
 void RewriterCompilingJitty::BuildRewriteSystem()
@@ -2966,25 +3362,58 @@ void RewriterCompilingJitty::BuildRewriteSystem()
   }
 
   std::string cpp_file = generate_cpp_filename(reinterpret_cast<std::size_t>(this));
-  generate_code(cpp_file);
-
-  mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
-  time.reset();
+  const compiled_rewriter_cache cache;
+  const std::string key = cache.enabled() ? compiled_rewriter_cache::key(compiled_rewriter_description(compile_script)) : std::string();
 
-  try
+  if (cache.enabled() && cache.find(key, cpp_file + ".bin") && load_relocation_information(cache.relocation_filename(key)))
   {
-    rewriter_so->compile(cpp_file);
+    rewriter_so->use_compiled(cpp_file + ".bin");
+    initialise_function_tables();
+    set_normal_forms_for_constants();
+    mCRL2log(verbose) << "found the compiled rewriter " << cache.library_filename(key) << " in " << time.time() << "ms (" 
+                      << cache.hit(key) << "), loading rewriter..." << std::endl;
   }
-  catch(std::runtime_error& e)
+  else
   {
-    rewriter_so->leave_files();
-    throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
-  }
+    const std::vector<std::string> cpp_files = generate_code(cpp_file);
 
-  mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+    mCRL2log(verbose) << "generated " << cpp_file;
+    if (cpp_files.size() > 1)
+    {
+      mCRL2log(verbose) << " and " << cpp_files.size() - 1 << " further translation unit" << (cpp_files.size() > 2 ? "s" : "");
+    }
+    mCRL2log(verbose) << " in " << time.time() << "ms, compiling..." << std::endl;
+    time.reset();
+
+    try
+    {
+      rewriter_so->compile(cpp_files);
+    }
+    catch(std::runtime_error& e)
+    {
+      rewriter_so->leave_files();
+      throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+    }
+
+    mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+
+    if (cache.enabled())
+    {
+      try
+      {
+        const std::string statistics = cache.store(key, rewriter_so->library_filename(), 
+                                                   [this](const std::string& filename){ save_relocation_information(filename); });
+        mCRL2log(verbose) << "stored the compiled rewriter as " << cache.library_filename(key) << " (" << statistics << ")." << std::endl;
+      }
+      catch (std::runtime_error& e)
+      {
+        mCRL2log(warning) << e.what() << std::endl;
+      }
+    }
+  }
 
   bool (*init)(rewriter_interface*, RewriterCompilingJitty* this_rewriter);
-  rewriter_interface interface = { mcrl2::utilities::get_toolset_version(), "Unknown error when loading rewriter.", this, nullptr, nullptr };
+  rewriter_interface interface = { mcrl2::utilities::get_toolset_version(), "Unknown error when loading rewriter.", this, m_nf_cache->terms().data(), nullptr, nullptr };
   try
   {
     typedef bool rewrite_function_type(rewriter_interface*, RewriterCompilingJitty*);
@@ -237,12 +237,40 @@ strategy RewriterJitty::create_a_cpp_function_based_strategy(const function_symb
   return strategy(0,result);
 }
 
+// Create a strategy for a function on numbers that can be evaluated using machine words. All arguments
+// are rewritten first, after which the machine word implementation is tried. If the arguments are not
+// constants that fit in a machine word, the rewrite rules are applied to the rewritten arguments.
+strategy RewriterJitty::create_a_machine_number_based_strategy(const machine_number_function& native, const strategy& rules_strategy, std::size_t arity)
+{
+  std::vector<strategy_rule> result;
+  for(size_t i=0; i<arity; ++i)
+  {
+    result.push_back(strategy_rule(i));
+  }
+  result.push_back(strategy_rule(native));
+
+  for(const strategy_rule& rule: rules_strategy.rules())
+  {
+    if (!rule.is_rewrite_index() || rule.rewrite_index()>=arity)
+    {
+      result.push_back(rule);
+    }
+  }
+  return strategy(rules_strategy.number_of_variables(),result);
+}
+
 // Create a strategy to rewrite terms. This can either be a strategy that is based on rewrite
 // rules or it can be a strategy based on an explicitly given c++ function for this function symbol. 
 strategy RewriterJitty::create_strategy(const function_symbol& f, const data_equation_list& rules1, const data_specification& data_spec)
 {
   if (data_spec.cpp_implemented_functions().count(f)==0)    // There is no explicit implementation.
   {
+    const machine_number_function native(f);
+    if (native.defined())
+    {
+      const std::size_t arity=atermpp::down_cast<function_sort>(f.sort()).domain().size();
+      return create_a_machine_number_based_strategy(native, create_a_rewriting_based_strategy(f, rules1), arity);
+    }
     return create_a_rewriting_based_strategy(f, rules1);
   } 
   else 
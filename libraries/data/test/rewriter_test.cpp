@@ -244,6 +244,54 @@ void test_enumeration_of_functions()
   test_expressions(R, expr1, expr2, "", data_spec, sigma);
 }
 
+#if defined(MCRL2_TEST_JITTYC) && defined(MCRL2_JITTYC_AVAILABLE)
+// The second compiling rewriter for the same specification is loaded from the cache
+// with compiled rewriters, and must rewrite in the same way as the first one. 
+void test_compiled_rewriter_cache()
+{
+  std::string DATA_SPEC1 =
+    "sort D = struct d1 | d2(arg:Nat);\n"
+    "map  f: List(Nat) -> Nat;\n"
+    "     g: Nat -> (Nat -> Nat);\n"
+    "var  n,m: Nat; l: List(Nat);\n"
+    "eqn  f([]) = 0;\n"
+    "     f(n |> l) = n + f(l);\n"
+    "     g(n) = lambda m: Nat. m + n;\n"
+    ;
+
+  data_specification data_spec = parse_data_specification(DATA_SPEC1);
+  setenv("MCRL2_COMPILEREWRITER_CACHE", "compiled_rewriter_cache_test", 1);
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    data::rewriter R(data_spec, jitty_compiling);
+    test_expressions(R, "f([1,2,3])", "Pos2Nat(6)", "", data_spec, "[]");
+    test_expressions(R, "g(2)(5)", "Pos2Nat(7)", "", data_spec, "[]");
+    test_expressions(R, "arg(d2(f([4]))) == 4", "true", "", data_spec, "[]");
+    test_expressions(R, "exists x: Nat. x < 3 && f([x, x]) == 4", "true", "", data_spec, "[]");
+  }
+  unsetenv("MCRL2_COMPILEREWRITER_CACHE");
+}
+
+// The generated rewriter is split over several translation units.
+void test_compiled_rewriter_translation_units()
+{
+  std::string DATA_SPEC1 =
+    "map  f: List(Nat) -> Nat;\n"
+    "var  n: Nat; l: List(Nat);\n"
+    "eqn  f([]) = 0;\n"
+    "     f(n |> l) = n + f(l);\n"
+    ;
+
+  data_specification data_spec = parse_data_specification(DATA_SPEC1);
+  setenv("MCRL2_COMPILEREWRITER_JOBS", "3", 1);
+  data::rewriter R(data_spec, jitty_compiling);
+  test_expressions(R, "f([1,2,3])", "Pos2Nat(6)", "", data_spec, "[]");
+  test_expressions(R, "exists x: Nat. x < 3 && f([x, x]) == 4", "true", "", data_spec, "[]");
+  test_expressions(R, "[2, 1] < [2, 3]", "true", "", data_spec, "[]");
+  unsetenv("MCRL2_COMPILEREWRITER_JOBS");
+}
+#endif // MCRL2_TEST_JITTYC
+
 BOOST_AUTO_TEST_CASE(test_main)
 {
   test1();
@@ -255,4 +303,8 @@ BOOST_AUTO_TEST_CASE(test_main)
   test_lambda_expression();
   test_equality_on_functions();
   test_enumeration_of_functions();
+#if defined(MCRL2_TEST_JITTYC) && defined(MCRL2_JITTYC_AVAILABLE)
+  test_compiled_rewriter_cache();
+  test_compiled_rewriter_translation_units();
+#endif
 }
@@ -11,10 +11,12 @@
 
 #define BOOST_TEST_MODULE rewriting_test
 #include "mcrl2/data/bag.h"
+#include "mcrl2/data/detail/normal_form_cache_size.h"
 #include "mcrl2/data/detail/rewrite_strategies.h"
 #include "mcrl2/data/list.h"
 #include "mcrl2/data/parse.h"
 #include "mcrl2/data/rewriter.h"
+#include "mcrl2/data/substitutions/mutable_map_substitution.h"
 
 #include <boost/test/included/unit_test.hpp>
 
@@ -247,6 +249,58 @@ BOOST_AUTO_TEST_CASE(int_rewrite_test)
   }
 }
 
+// Arithmetic on constants that fit in a machine word is evaluated directly, and other
+// arguments are rewritten using the rewrite rules. The results must be the same.
+BOOST_AUTO_TEST_CASE(machine_number_rewrite_test)
+{
+  std::cerr << "machine_number_rewrite_test\n";
+
+  data_specification specification;
+  specification.add_context_sort(sort_int::int_());
+
+  data::variable_vector v;
+  v.push_back(data::variable("n", sort_nat::nat()));
+  v.push_back(data::variable("x", sort_int::int_()));
+
+  const std::vector<std::pair<std::string, std::string> > tests = {
+    { "123456789 * 987654321", "121932631112635269" },
+    { "-7 div 2", "-4" },
+    { "-7 mod 2", "Pos2Nat(1)" },
+    { "-8 mod 2", "0" },
+    { "7 - 12", "-5" },
+    { "max(-3, -2)", "-2" },
+    { "min(Pos2Nat(3), 0)", "0" },
+    { "pred(0)", "-1" },
+    { "abs(-42)", "Pos2Nat(42)" },
+    { "Int2Nat(-1 + 3)", "Pos2Nat(2)" },
+    { "exp(-3, 3)", "-27" },
+    { "12345 < 12346", "true" },
+    { "-5 >= 3", "false" },
+    { "1024 == 1024", "true" },
+    // The arguments or the result do not fit in a machine word.
+    { "4611686018427387904 + 4611686018427387904", "9223372036854775808" },
+    { "3037000500 * 3037000500", "9223372037000250000" },
+    { "exp(2, 70)", "1180591620717411303424" },
+    { "-9223372036854775808 - 1", "-9223372036854775809" },
+    // The arguments are not constants.
+    { "n + 0", "n" },
+    { "0 + n", "n" },
+    { "x < x + 1", "x < x + 1" },
+  };
+
+  rewrite_strategy_vector strategies(data::detail::get_test_rewrite_strategies(false));
+  for (rewrite_strategy_vector::const_iterator strat = strategies.begin(); strat != strategies.end(); ++strat)
+  {
+    std::cerr << "  Strategy: " << *strat << std::endl;
+    data::rewriter R(specification, *strat);
+
+    for (const std::pair<std::string, std::string>& test: tests)
+    {
+      data_rewrite_test(R, parse_data_expression(test.first, v, specification), R(parse_data_expression(test.second, v, specification)));
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(real_rewrite_test)
 {
   using namespace mcrl2::data::sort_real;
@@ -1522,3 +1576,52 @@ BOOST_AUTO_TEST_CASE(Problem_with_recursive_templates_in_jittyc)   // This rewri
     data_rewrite_test(R, e, f);
   }
 }
+
+BOOST_AUTO_TEST_CASE(rewrite_with_a_normal_form_cache)   // The normal forms of closed terms are cached, and must not be
+                                                         // used for terms with variables, also not when these variables
+                                                         // are bound inside a closed term.
+{
+  std::string s(
+  "map f:Nat->Nat;\n"
+  "    g:Nat->(Nat->Nat);\n"
+  "var n,m:Nat;\n"
+  "eqn f(n)=n+1;\n"
+  "    g(n)=lambda m:Nat.f(m)+n;\n"
+  );
+
+  data_specification specification(parse_data_specification(s));
+  data::variable n("n", sort_nat::nat());
+  data::function_symbol f_symbol("f", make_function_sort_(sort_nat::nat(), sort_nat::nat()));
+  auto f = [&](const data_expression& x) { return application(f_symbol, x); };
+  data::detail::set_normal_form_cache_size(16);
+
+  rewrite_strategy_vector strategies(data::detail::get_test_rewrite_strategies(false));
+  for (rewrite_strategy_vector::const_iterator strat = strategies.begin(); strat != strategies.end(); ++strat)
+  {
+    std::cerr << "  Strategy33: " << *strat << std::endl;
+    data::rewriter R(specification, *strat);
+
+    // Rewrite every term twice, such that the second time the cache is used.
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+      data_rewrite_test(R, parse_data_expression("f(3)+f(3)", specification), R(sort_nat::nat(8)));
+      data_rewrite_test(R, parse_data_expression("g(1)(2)+g(1)(4)", specification), R(sort_nat::nat(10)));
+      data_rewrite_test(R, parse_data_expression("(lambda m:Nat.f(m))(2)+(lambda m:Nat.f(m))(4)", specification), R(sort_nat::nat(8)));
+      data_rewrite_test(R, parse_data_expression("exists m:Nat.m<3 && f(m)==3", specification), sort_bool::true_());
+
+      data::mutable_map_substitution<> sigma;
+      for (std::size_t k = 0; k < 4; ++k)
+      {
+        sigma[n] = sort_nat::nat(k);
+        BOOST_CHECK(R(f(n), sigma) == R(sort_nat::nat(k + 1)));
+      }
+    }
+
+    // More terms than the size of the cache are rewritten.
+    for (std::size_t k = 0; k < 64; ++k)
+    {
+      data_rewrite_test(R, f(sort_nat::nat(k)), R(sort_nat::nat(k + 1)));
+    }
+  }
+  data::detail::set_normal_form_cache_size(0);
+}
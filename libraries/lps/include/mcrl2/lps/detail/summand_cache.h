@@ -0,0 +1,155 @@
+// Author(s): Wieger Wesselink, Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/detail/summand_cache.h
+/// \brief A cache for the solutions of summand conditions that can be
+///        used by multiple threads, and that has a bounded size.
+
+#ifndef MCRL2_LPS_DETAIL_SUMMAND_CACHE_H
+#define MCRL2_LPS_DETAIL_SUMMAND_CACHE_H
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include "mcrl2/atermpp/standard_containers/deque.h"
+#include "mcrl2/atermpp/standard_containers/unordered_map.h"
+#include "mcrl2/data/data_expression.h"
+
+namespace mcrl2::lps::detail {
+
+/// \brief A cache that maps the values of the free variables in the condition of a summand
+///        to the solutions of the condition for the summation variables.
+/// \details The cache is split into shards based on the hash of the key. Each shard has its
+///          own mutex, such that threads that use different shards do not block each other.
+///          If the number of elements in a shard exceeds its maximum, the element that was
+///          inserted first in this shard is removed. The keys and solutions are protected
+///          by the atermpp containers, which are created by the thread that creates the cache.
+///          Other threads only store terms in these containers, because a term that is
+///          created by one thread must not be destroyed by another.
+class summand_cache
+{
+  public:
+    using key_type = atermpp::term_appl<data::data_expression>;
+    using solution_list = atermpp::term_list<data::data_expression_list>;
+
+  protected:
+    using map_type = atermpp::unordered_map<key_type, atermpp::detail::reference_aterm<solution_list>>;
+
+    struct shard
+    {
+      std::mutex mutex;
+      map_type map;
+      atermpp::deque<key_type> insertion_order; // The keys in the order in which they were inserted.
+      std::size_t hits = 0;
+      std::size_t misses = 0;
+      std::size_t evictions = 0;
+    };
+
+    std::vector<std::unique_ptr<shard>> m_shards;
+    std::size_t m_maximum_shard_size;
+    bool m_thread_safe;
+
+    shard& get_shard(const key_type& key) const
+    {
+      return *m_shards[std::hash<atermpp::aterm>()(key) % m_shards.size()];
+    }
+
+  public:
+    /// \brief Constructor.
+    /// \param number_of_shards The number of independently locked parts of the cache.
+    /// \param maximum_size The maximum number of elements in the cache, where 0 means that the size is unbounded.
+    /// \param thread_safe If false, the cache is only used by one thread and no locks are taken.
+    explicit summand_cache(std::size_t number_of_shards = 1, std::size_t maximum_size = 0, bool thread_safe = false)
+      : m_thread_safe(thread_safe)
+    {
+      assert(number_of_shards > 0);
+      for (std::size_t i = 0; i < number_of_shards; i++)
+      {
+        m_shards.push_back(std::make_unique<shard>());
+      }
+      m_maximum_shard_size = maximum_size == 0 ? 0 : std::max<std::size_t>(1, maximum_size / number_of_shards);
+    }
+
+    /// \brief Looks up the solutions for key.
+    /// \return True if the key is in the cache, in which case its solutions are assigned to result.
+    bool find(const key_type& key, solution_list& result)
+    {
+      shard& s = get_shard(key);
+      std::unique_lock<std::mutex> lock(s.mutex, std::defer_lock);
+      if (m_thread_safe)
+      {
+        lock.lock();
+      }
+      auto i = s.map.find(key);
+      if (i == s.map.end())
+      {
+        s.misses++;
+        return false;
+      }
+      s.hits++;
+      result = static_cast<const solution_list&>(i->second);
+      return true;
+    }
+
+    /// \brief Stores the solutions for key. If the key is already present, e.g. because another
+    ///        thread inserted it in the meantime, the cache is not changed.
+    void insert(const key_type& key, const solution_list& solutions)
+    {
+      shard& s = get_shard(key);
+      std::unique_lock<std::mutex> lock(s.mutex, std::defer_lock);
+      if (m_thread_safe)
+      {
+        lock.lock();
+      }
+      if (s.map.find(key) != s.map.end())
+      {
+        return;
+      }
+      if (m_maximum_shard_size > 0 && s.map.size() >= m_maximum_shard_size)
+      {
+        s.map.erase(static_cast<const key_type&>(s.insertion_order.front()));
+        s.insertion_order.pop_front();
+        s.evictions++;
+      }
+      s.map.emplace(key, solutions);
+      s.insertion_order.push_back(key);
+    }
+
+    /// \brief Returns the number of elements in the cache.
+    /// \details Should not be called while other threads use the cache.
+    std::size_t size() const
+    {
+      std::size_t result = 0;
+      for (const std::unique_ptr<shard>& s: m_shards)
+      {
+        result += s->map.size();
+      }
+      return result;
+    }
+
+    /// \brief Returns the number of successful lookups, failed lookups and removed elements.
+    /// \details Should not be called while other threads use the cache.
+    std::tuple<std::size_t, std::size_t, std::size_t> statistics() const
+    {
+      std::size_t hits = 0;
+      std::size_t misses = 0;
+      std::size_t evictions = 0;
+      for (const std::unique_ptr<shard>& s: m_shards)
+      {
+        hits += s->hits;
+        misses += s->misses;
+        evictions += s->evictions;
+      }
+      return { hits, misses, evictions };
+    }
+};
+
+} // namespace mcrl2::lps::detail
+
+#endif // MCRL2_LPS_DETAIL_SUMMAND_CACHE_H
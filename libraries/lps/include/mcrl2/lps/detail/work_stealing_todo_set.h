@@ -0,0 +1,28 @@
+// Author(s): Wieger Wesselink, Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/detail/work_stealing_todo_set.h
+/// \brief A todo set for the multi-threaded explorer in which every thread has
+///        its own queue of states, and idle threads steal work from others.
+
+#ifndef MCRL2_LPS_DETAIL_WORK_STEALING_TODO_SET_H
+#define MCRL2_LPS_DETAIL_WORK_STEALING_TODO_SET_H
+
+#include "mcrl2/atermpp/standard_containers/deque.h"
+#include "mcrl2/lps/state.h"
+#include "mcrl2/utilities/detail/work_stealing_todo_set.h"
+
+namespace mcrl2::lps::detail {
+
+/// \brief A set of per thread queues of states that are still to be explored, see
+///        utilities::detail::work_stealing_todo_set.
+typedef utilities::detail::work_stealing_todo_set<state, atermpp::deque<state>> work_stealing_todo_set;
+
+} // namespace mcrl2::lps::detail
+
+#endif // MCRL2_LPS_DETAIL_WORK_STEALING_TODO_SET_H
@@ -19,11 +19,12 @@
 #include "mcrl2/utilities/skip.h"
 #include "mcrl2/atermpp/standard_containers/deque.h"
 #include "mcrl2/atermpp/standard_containers/vector.h"
-#include "mcrl2/atermpp/standard_containers/indexed_set.h"
 #include "mcrl2/data/consistency.h"
 #include "mcrl2/data/enumerator.h"
 #include "mcrl2/data/substitution_utility.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
+#include "mcrl2/lps/detail/summand_cache.h"
+#include "mcrl2/lps/detail/work_stealing_todo_set.h"
 #include "mcrl2/lps/explorer_options.h"
 #include "mcrl2/lps/find_representative.h"
 #include "mcrl2/lps/one_point_rule_rewrite.h"
@@ -31,6 +32,7 @@
 #include "mcrl2/lps/replace_constants_by_variables.h"
 #include "mcrl2/lps/resolve_name_clashes.h"
 #include "mcrl2/lps/stochastic_state.h"
+#include "mcrl2/lps/tree_state_set.h"
 
 namespace mcrl2::lps {
 
@@ -243,10 +245,16 @@ struct explorer_summand
   caching cache_strategy;
   std::vector<data::variable> gamma;
   atermpp::function_symbol f_gamma;
-  mutable utilities::unordered_map<atermpp::term_appl<data::data_expression>, std::list<data::data_expression_list>> local_cache;
+  std::shared_ptr<detail::summand_cache> local_cache; // Shared by copies of this summand.
 
   template <typename ActionSummand>
-  explorer_summand(const ActionSummand& summand, std::size_t summand_index, const data::variable_list& process_parameters, caching cache_strategy_)
+  explorer_summand(const ActionSummand& summand,
+                   std::size_t summand_index,
+                   const data::variable_list& process_parameters,
+                   caching cache_strategy_,
+                   std::size_t cache_shards = 1,
+                   std::size_t cache_size = 0,
+                   bool thread_safe_cache = false)
     : variables(summand.summation_variables()),
       condition(summand.condition()),
       multi_action(summand.multi_action()),
@@ -255,6 +263,10 @@ struct explorer_summand
       index(summand_index),
       cache_strategy(cache_strategy_)
   {
+    if (cache_strategy_ == caching::local)
+    {
+      local_cache = std::make_shared<detail::summand_cache>(cache_shards, cache_size, thread_safe_cache);
+    }
     gamma = free_variables(summand.condition(), process_parameters);
     if (cache_strategy_ == caching::global)
     {
@@ -339,7 +351,8 @@ class explorer: public abortable
     static constexpr bool is_stochastic = Stochastic;
     static constexpr bool is_timed = Timed;
 
-    typedef atermpp::indexed_set<state, atermpp::detail::GlobalThreadSafe> indexed_set_for_states_type;
+    // The discovered states are stored in a tree compressed form, such that the state terms are not kept alive.
+    typedef tree_state_set indexed_set_for_states_type;
 
   protected:
     using enumerator_element = data::enumerator_list_element_with_substitution<>;
@@ -354,6 +367,26 @@ class explorer: public abortable
       {}
     };
 
+    // A transition that is stored in a thread local buffer, until it is reported via examine_transition.
+    struct buffered_transition
+    {
+      state source;
+      std::size_t source_index;
+      lps::multi_action action;
+      state_type target;
+      state_index_type target_index;
+      std::size_t summand_index;
+
+      buffered_transition(const state& source_, std::size_t source_index_, const lps::multi_action& action_,
+                          const state_type& target_, const state_index_type& target_index_, std::size_t summand_index_)
+       : source(source_), source_index(source_index_), action(action_),
+         target(target_), target_index(target_index_), summand_index(summand_index_)
+      {}
+    };
+
+    // The number of transitions that a thread collects before they are reported in one go.
+    static constexpr std::size_t transition_buffer_size = 1024;
+
     const explorer_options& m_options;
 
     // The four data structures that must be separate per thread.
@@ -379,7 +412,7 @@ class explorer: public abortable
     volatile bool m_must_abort = false;
 
     // N.B. The keys are stored in term_appl instead of data_expression_list for performance reasons.
-    utilities::unordered_map<atermpp::term_appl<data::data_expression>, std::list<data::data_expression_list>> global_cache;
+    detail::summand_cache global_cache;
 
     indexed_set_for_states_type m_discovered;
 
@@ -640,16 +673,13 @@ class explorer: public abortable
       }
       else
       {
-        static std::mutex cache_mutex; // This mutex could be created per summand. This may allow for more parallel behaviour if required. 
         summand.compute_key(key, sigma);
-        auto& cache = summand.cache_strategy == caching::global ? global_cache : summand.local_cache;
-        if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) cache_mutex.lock();
-        auto q = cache.find(key);
-        if (q == cache.end())
+        detail::summand_cache& cache = summand.cache_strategy == caching::global ? global_cache : *summand.local_cache;
+        detail::summand_cache::solution_list solutions;
+        if (!cache.find(key, solutions))
         {
-          if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) cache_mutex.unlock();
           rewr(condition, summand.condition, sigma);
-          std::list<data::data_expression_list> solutions;
+          std::vector<data::data_expression_list> enumerated_solutions;
           if (!data::is_false(condition))
           {
             enumerator.enumerate<enumerator_element>(
@@ -658,19 +688,18 @@ class explorer: public abortable
                         sigma,
                         [&](const enumerator_element& p) {
                           check_enumerator_solution(p.expression(), summand, sigma, rewr);
-                          solutions.push_back(p.assign_expressions(summand.variables, rewr));
+                          enumerated_solutions.push_back(p.assign_expressions(summand.variables, rewr));
                           return false;
                         },
                         data::is_false
                       );
           }
-          if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) cache_mutex.lock();
-          q = cache.insert({key, solutions}).first;
+          solutions = detail::summand_cache::solution_list(enumerated_solutions.begin(), enumerated_solutions.end());
+          cache.insert(key, solutions);
         }
-        if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) cache_mutex.unlock();
 
         // state_type s1;
-        for (const data::data_expression_list& e: q->second)
+        for (const data::data_expression_list& e: solutions)
         {
           data::add_assignments(sigma, summand.variables, e);
           if constexpr (Stochastic)
@@ -852,6 +881,50 @@ class explorer: public abortable
       }
     }
 
+    // The number of independently locked parts of the enumeration caches.
+    std::size_t cache_shards() const
+    {
+      return m_options.number_of_threads > 1 ? 4 * m_options.number_of_threads : 1;
+    }
+
+    // Reports the effectiveness of the enumeration caches.
+    void report_cache_statistics() const
+    {
+      if (!m_options.cached)
+      {
+        return;
+      }
+      std::size_t size = 0;
+      std::size_t hits = 0;
+      std::size_t misses = 0;
+      std::size_t evictions = 0;
+      auto add_statistics = [&](const detail::summand_cache& cache)
+      {
+        auto [h, m, e] = cache.statistics();
+        size += cache.size();
+        hits += h;
+        misses += m;
+        evictions += e;
+      };
+      if (m_options.global_cache)
+      {
+        add_statistics(global_cache);
+      }
+      else
+      {
+        for (const explorer_summand& summand: m_regular_summands)
+        {
+          add_statistics(*summand.local_cache);
+        }
+        for (const explorer_summand& summand: m_confluent_summands)
+        {
+          add_statistics(*summand.local_cache);
+        }
+      }
+      mCRL2log(log::verbose) << "enumeration cache: " << size << " entries, " << hits << " hits, "
+                             << misses << " misses, " << evictions << " evictions." << std::endl;
+    }
+
     bool is_confluent_tau(const multi_action& a)
     {
       if (a.actions().empty())
@@ -871,7 +944,8 @@ class explorer: public abortable
         m_global_rewr(construct_rewriter(lpsspec, m_options.remove_unused_rewrite_rules)),
         m_global_enumerator(m_global_rewr, lpsspec.data(), m_global_rewr, m_global_id_generator, false),
         m_global_lpsspec(preprocess(lpsspec)),
-        m_discovered(m_options.number_of_threads)
+        global_cache(cache_shards(), m_options.cache_size, m_options.number_of_threads > 1),
+        m_discovered(m_global_lpsspec.process().process_parameters().size() + (Timed && !Stochastic ? 1 : 0), m_options.number_of_threads)
     {
       const data::variable_list& params = m_global_lpsspec.process().process_parameters();
       m_process_parameters = std::vector<data::variable>(params.begin(), params.end());
@@ -888,11 +962,13 @@ class explorer: public abortable
         auto cache_strategy = m_options.cached ? (m_options.global_cache ? lps::caching::global : lps::caching::local) : lps::caching::none;
         if (is_confluent_tau(summand.multi_action()))
         {
-          m_confluent_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy);
+          m_confluent_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy,
+                                            cache_shards(), m_options.cache_size, m_options.number_of_threads > 1);
         }
         else
         {
-          m_regular_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy);
+          m_regular_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy,
+                                          cache_shards(), m_options.cache_size, m_options.number_of_threads > 1);
         }
       }
     }
@@ -924,6 +1000,165 @@ class explorer: public abortable
       return s;
     }
 
+    // Reports the transitions in the buffer via examine_transition, and clears the buffer. The
+    // transition mutex is only taken once for the whole buffer.
+    template <typename ExamineTransition>
+    void flush_transition_buffer(
+      const std::size_t thread_index,
+      std::vector<buffered_transition>& transition_buffer,
+      ExamineTransition& examine_transition
+    )
+    {
+      if (transition_buffer.empty())
+      {
+        return;
+      }
+      std::lock_guard<std::mutex> guard(m_exclusive_transition_access);
+      for (const buffered_transition& t: transition_buffer)
+      {
+        examine_transition(thread_index, t.source, t.source_index, t.action, t.target, t.target_index, t.summand_index);
+      }
+      transition_buffer.clear();
+    }
+
+    // Reports a transition via examine_transition. With multiple threads the transition is stored in the
+    // transition buffer of the thread, which is flushed when it is full. This avoids that the transition
+    // mutex must be taken for every transition.
+    template <typename ExamineTransition>
+    void report_transition(
+      const std::size_t thread_index,
+      const state& s0,
+      const std::size_t s0_index,
+      const lps::multi_action& a,
+      const state_type& s1,
+      const state_index_type& s1_index,
+      const std::size_t summand_index,
+      std::vector<buffered_transition>& transition_buffer,
+      ExamineTransition& examine_transition
+    )
+    {
+      if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1)
+      {
+        transition_buffer.emplace_back(s0, s0_index, a, s1, s1_index, summand_index);
+        if (transition_buffer.size() >= transition_buffer_size)
+        {
+          flush_transition_buffer(thread_index, transition_buffer, examine_transition);
+        }
+      }
+      else
+      {
+        examine_transition(thread_index, s0, s0_index, a, s1, s1_index, summand_index);
+      }
+    }
+
+    // Explores the outgoing transitions of current_state. The states that are discovered
+    // for the first time are added to newly_found_states.
+    template <
+      typename SummandSequence,
+      typename DiscoverState,
+      typename ExamineTransition
+    >
+    void generate_state_space_explore_state(
+      const std::size_t thread_index,
+      const state& current_state,
+      const std::size_t s_index,
+      const SummandSequence& regular_summands,
+      const SummandSequence& confluent_summands,
+      indexed_set_for_states_type& discovered,
+      DiscoverState& discover_state,
+      ExamineTransition& examine_transition,
+      data::rewriter& thread_rewr,
+      data::mutable_indexed_substitution<>& thread_sigma,
+      data::enumerator_algorithm<>& thread_enumerator,
+      data::enumerator_identifier_generator& thread_id_generator,
+      data::data_expression& condition,
+      state_type& state_,
+      atermpp::term_appl<data::data_expression>& key,
+      atermpp::vector<state>& newly_found_states,
+      std::vector<buffered_transition>& transition_buffer
+    )
+    {
+      data::add_assignments(thread_sigma, m_process_parameters, current_state);
+      for (const explorer_summand& summand: regular_summands)
+      {   
+        generate_transitions(
+          summand,
+          confluent_summands,
+          thread_sigma,
+          thread_rewr,
+          condition,
+          state_,
+          key,
+          thread_enumerator,
+          thread_id_generator,
+          [&](const lps::multi_action& a, const state_type& s1)
+          {   
+            if constexpr (Timed)
+            { 
+              const data::data_expression& t = current_state[m_n];
+              if (a.has_time() && less_equal(a.time(), t, thread_sigma, thread_rewr))
+              {
+                return;
+              }
+            } 
+            if constexpr (Stochastic)
+            { 
+              std::list<std::size_t> s1_index;
+              const auto& S1 = s1.states;
+              // TODO: join duplicate targets
+              // if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_indexed_set_access.lock();
+              for (const state& s1_: S1)
+              { 
+                std::size_t k = discovered.index(s1_,thread_index);
+                if (k >= discovered.size())
+                { 
+                  newly_found_states.push_back(s1_);
+                  k = discovered.insert(s1_, thread_index).first;
+                  discover_state(thread_index, s1_, k);
+                }
+                s1_index.push_back(k);
+              }
+              // if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_indexed_set_access.unlock();
+
+              report_transition(thread_index, current_state, s_index, a, s1, s1_index, summand.index, transition_buffer, examine_transition);
+            } 
+            else 
+            { 
+              std::size_t s1_index; 
+              // if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_indexed_set_access.lock();
+              if constexpr (Timed)
+              { 
+                s1_index = discovered.index(s1,thread_index);
+                if (s1_index >= discovered.size())
+                {   
+                  const data::data_expression& t = current_state[m_n];
+                  const data::data_expression& t1 = a.has_time() ? a.time() : t;
+                  make_timed_state(state_, s1, t1);
+                  s1_index = discovered.insert(state_, thread_index).first;
+                  // if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_indexed_set_access.unlock();
+                  discover_state(thread_index, state_, s1_index);
+                  newly_found_states.push_back(state_);
+                } 
+              }
+              else
+              { 
+                std::pair<std::size_t,bool> p = discovered.insert(s1, thread_index);
+                // if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_indexed_set_access.unlock();
+                s1_index=p.first;
+                if (p.second)  // Index is newly added. 
+                {
+                  discover_state(thread_index, s1, s1_index);
+                  newly_found_states.push_back(s1); 
+                }
+              }
+
+              report_transition(thread_index, current_state, s_index, a, s1, s1_index, summand.index, transition_buffer, examine_transition);
+            }
+          }
+        );
+      }
+    }
+
     template <
       typename StateType,
       typename SummandSequence,
@@ -958,6 +1193,7 @@ class explorer: public abortable
       state_type state_;                 // The same holds for state.
       atermpp::term_appl<data::data_expression> key;  
       atermpp::vector<state> newly_found_states; // The new states for each process are temporarily stored in this vector for each thread. 
+      std::vector<buffered_transition> transition_buffer; // Transitions that are not yet reported via examine_transition.
       while (number_of_active_processes>0)
       {
         if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.lock();
@@ -967,89 +1203,10 @@ class explorer: public abortable
           std::size_t s_index = discovered.index(current_state,thread_index);
           if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.unlock();
           start_state(thread_index, current_state, s_index);
-          data::add_assignments(thread_sigma, m_process_parameters, current_state);
-          for (const explorer_summand& summand: regular_summands)
-          {   
-            generate_transitions(
-              summand,
-              confluent_summands,
-              thread_sigma,
-              thread_rewr,
-              condition,
-              state_,
-              key,
-              thread_enumerator,
-              thread_id_generator,
-              [&](const lps::multi_action& a, const state_type& s1)
-              {   
-                if constexpr (Timed)
-                { 
-                  const data::data_expression& t = current_state[m_n];
-                  if (a.has_time() && less_equal(a.time(), t, thread_sigma, thread_rewr))
-                  {
-                    return;
-                  }
-                } 
-                if constexpr (Stochastic)
-                { 
-                  std::list<std::size_t> s1_index;
-                  const auto& S1 = s1.states;
-                  // TODO: join duplicate targets
-                  // if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_indexed_set_access.lock();
-                  for (const state& s1_: S1)
-                  { 
-                    std::size_t k = discovered.index(s1_,thread_index);
-                    if (k >= discovered.size())
-                    { 
-                      newly_found_states.push_back(s1_);
-                      k = discovered.insert(s1_, thread_index).first;
-                      discover_state(thread_index, s1_, k);
-                    }
-                    s1_index.push_back(k);
-                  }
-                  // if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_indexed_set_access.unlock();
-
-                  if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_transition_access.lock();
-                  examine_transition(thread_index, current_state, s_index, a, s1, s1_index, summand.index);
-                  if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_transition_access.unlock();
-                } 
-                else 
-                { 
-                  std::size_t s1_index; 
-                  // if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_indexed_set_access.lock();
-                  if constexpr (Timed)
-                  { 
-                    s1_index = discovered.index(s1,thread_index);
-                    if (s1_index >= discovered.size())
-                    {   
-                      const data::data_expression& t = current_state[m_n];
-                      const data::data_expression& t1 = a.has_time() ? a.time() : t;
-                      make_timed_state(state_, s1, t1);
-                      s1_index = discovered.insert(state_, thread_index).first;
-                      // if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_indexed_set_access.unlock();
-                      discover_state(thread_index, state_, s1_index);
-                      newly_found_states.push_back(state_);
-                    } 
-                  }
-                  else
-                  { 
-                    std::pair<std::size_t,bool> p = discovered.insert(s1, thread_index);
-                    // if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_indexed_set_access.unlock();
-                    s1_index=p.first;
-                    if (p.second)  // Index is newly added. 
-                    {
-                      discover_state(thread_index, s1, s1_index);
-                      newly_found_states.push_back(s1); 
-                    }
-                  }
-
-                  if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_transition_access.lock();
-                  examine_transition(thread_index, current_state, s_index, a, s1, s1_index, summand.index);
-                  if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_transition_access.unlock();
-                }
-              }
-            );
-          }
+          generate_state_space_explore_state(thread_index, current_state, s_index, regular_summands, confluent_summands,
+                                             discovered, discover_state, examine_transition, thread_rewr, thread_sigma,
+                                             thread_enumerator, thread_id_generator, condition, state_, key, newly_found_states,
+                                           transition_buffer);
           if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.lock();
           for(const state& s: newly_found_states)
           {
@@ -1071,10 +1228,79 @@ class explorer: public abortable
           number_of_active_processes++;
         }
       } 
+      flush_transition_buffer(thread_index, transition_buffer, examine_transition);
       mCRL2log(log::debug) << "Stop thread " << thread_index << ".\n";
 
     }  // end generate_state_space_thread.
 
+    // A variant of generate_state_space_thread in which every thread has its own queue of
+    // states to be explored, and steals states of other threads when its own queue is empty.
+    // Only the callback finish_state is protected by a mutex, as it receives the size of the todo set.
+    template <
+      typename StateType,
+      typename SummandSequence,
+      typename DiscoverState = utilities::skip,
+      typename ExamineTransition = utilities::skip,
+      typename StartState = utilities::skip,
+      typename FinishState = utilities::skip
+    >
+    void generate_state_space_work_stealing_thread(
+      detail::work_stealing_todo_set& todo,
+      const std::size_t thread_index,
+      const SummandSequence& regular_summands,
+      const SummandSequence& confluent_summands,
+      indexed_set_for_states_type& discovered,
+      DiscoverState discover_state,
+      ExamineTransition examine_transition,
+      StartState start_state,
+      FinishState finish_state,
+      data::rewriter thread_rewr,
+      data::mutable_indexed_substitution<> thread_sigma  // This is intentionally a copy. 
+    )
+    {
+      thread_rewr.thread_initialise();
+      mCRL2log(log::debug) << "Start thread " << thread_index << ".\n";
+      data::enumerator_identifier_generator thread_id_generator("t_");
+      data::data_specification thread_data_specification = m_global_lpsspec.data();
+      data::enumerator_algorithm<> thread_enumerator(thread_rewr, thread_data_specification, thread_rewr, thread_id_generator, false);
+      state current_state;
+      data::data_expression condition;
+      state_type state_;
+      atermpp::term_appl<data::data_expression> key;  
+      atermpp::vector<state> newly_found_states;
+      std::vector<buffered_transition> transition_buffer;
+      std::size_t explored_states = 0;
+      while (!m_must_abort)
+      {
+        if (!todo.choose_element(thread_index, current_state))
+        {
+          if (todo.empty())
+          {
+            break;
+          }
+          std::this_thread::yield();
+          continue;
+        }
+        std::size_t s_index = discovered.index(current_state,thread_index);
+        start_state(thread_index, current_state, s_index);
+        generate_state_space_explore_state(thread_index, current_state, s_index, regular_summands, confluent_summands,
+                                           discovered, discover_state, examine_transition, thread_rewr, thread_sigma,
+                                           thread_enumerator, thread_id_generator, condition, state_, key, newly_found_states,
+                                           transition_buffer);
+        todo.insert(thread_index, newly_found_states.begin(), newly_found_states.end());
+        newly_found_states.clear();
+        if constexpr (!std::is_same<FinishState, utilities::skip>::value)
+        {
+          std::lock_guard<std::mutex> guard(m_exclusive_state_access);
+          finish_state(thread_index, current_state, s_index, todo.size());
+        }
+        todo.finish_state();
+        explored_states++;
+      } 
+      flush_transition_buffer(thread_index, transition_buffer, examine_transition);
+      mCRL2log(log::debug) << "Stop thread " << thread_index << " after exploring " << explored_states << " states.\n";
+    }  // end generate_state_space_work_stealing_thread.
+
 
 
     // pre: s0 is in normal form
@@ -1109,11 +1335,25 @@ class explorer: public abortable
       std::unique_ptr<todo_set> todo;
       discovered.clear(initialisation_thread_index);
 
+      // With multiple threads the breadth and depth first strategies use a queue of states per thread.
+      std::unique_ptr<detail::work_stealing_todo_set> work_stealing_todo;
+      if (number_of_threads>1 && (m_options.search_strategy == lps::es_breadth || m_options.search_strategy == lps::es_depth))
+      {
+        work_stealing_todo = std::make_unique<detail::work_stealing_todo_set>(number_of_threads, m_options.search_strategy == lps::es_depth);
+      }
+
       if constexpr (Stochastic)
       {
         state_type s0_ = make_state(s0);
         const auto& S = s0_.states;
-        todo = make_todo_set(S.begin(), S.end());
+        if (work_stealing_todo)
+        {
+          work_stealing_todo->insert(1, S.begin(), S.end());
+        }
+        else
+        {
+          todo = make_todo_set(S.begin(), S.end());
+        }
         discovered.clear();
         std::list<std::size_t> s0_index;
         for (const state& s: S)
@@ -1131,14 +1371,43 @@ class explorer: public abortable
       }
       else
       {
-        todo = make_todo_set(s0);
+        if (work_stealing_todo)
+        {
+          work_stealing_todo->insert(1, s0);
+        }
+        else
+        {
+          todo = make_todo_set(s0);
+        }
         std::size_t s0_index = discovered.insert(s0, initialisation_thread_index).first;
         discover_state(initialisation_thread_index, s0, s0_index);
       }
 
       std::atomic<std::size_t> number_of_active_processes=number_of_threads;
 
-      if (number_of_threads>1)
+      if (work_stealing_todo)
+      {
+        std::vector<std::thread> threads;
+        threads.reserve(number_of_threads);
+        for(std::size_t i=1; i<=number_of_threads; ++i)
+        {
+          std::thread tr ([&, i](){ generate_state_space_work_stealing_thread< StateType, SummandSequence,
+                                                         DiscoverState, ExamineTransition,
+                                                         StartState, FinishState >
+                                  (*work_stealing_todo, i,
+                                   regular_summands,confluent_summands,discovered, discover_state,
+                                   examine_transition, start_state, finish_state, 
+                                   m_global_rewr.clone(), m_global_sigma); } );
+          threads.push_back(std::move(tr));
+        }
+
+        for(std::size_t i=1; i<=number_of_threads; ++i)
+        {
+          threads[i-1].join();
+        }
+        mCRL2log(log::debug) << "Number of times that states were stolen by a thread: " << work_stealing_todo->steal_count() << ".\n";
+      }
+      else if (number_of_threads>1)
       {
         std::vector<std::thread> threads;
         threads.reserve(number_of_threads);
@@ -1177,6 +1446,7 @@ class explorer: public abortable
                                    m_global_rewr, m_global_sigma);  
       }
 
+      report_cache_statistics();
       m_must_abort = false;
     }
 
@@ -49,6 +49,7 @@ struct explorer_options
   std::size_t max_states = std::numeric_limits<std::size_t>::max();
   std::size_t max_traces = 0;
   std::size_t highway_todo_max = std::numeric_limits<std::size_t>::max();
+  std::size_t cache_size = 0;     // The maximum number of entries in an enumeration cache, where 0 means unbounded.
   std::size_t number_of_threads = 1;
   std::string trace_prefix;
   std::set<core::identifier_string> trace_actions;
@@ -64,6 +65,7 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "search-strategy = " << options.search_strategy << std::endl;
   out << "cached = " << std::boolalpha << options.cached << std::endl;
   out << "global-cache = " << std::boolalpha << options.global_cache << std::endl;
+  out << "cache-size = " << options.cache_size << std::endl;
   out << "confluence = " << std::boolalpha << options.confluence << std::endl;
   out << "confluence-action = " << options.confluence << std::endl;
   out << "one-point-rule-rewrite = " << std::boolalpha << options.one_point_rule_rewrite << std::endl;
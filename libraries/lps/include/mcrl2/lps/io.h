@@ -42,7 +42,7 @@ template <typename Specification>
 void save_lps(const Specification& spec, std::ostream& stream, const std::string& target = "")
 {
   mCRL2log(log::verbose) << "Saving LPS" << (target.empty()?"":" to " + target) << ".\n";
-  atermpp::binary_aterm_ostream(stream) << spec;
+  atermpp::chunked_binary_aterm_ostream(stream) << spec;
 }
 
 /// \brief Load LPS from file.
@@ -24,6 +24,7 @@
 #include "mcrl2/lps/symbolic_lts.h"
 #include "mcrl2/symbolic/ordering.h"
 #include "mcrl2/symbolic/print.h"
+#include "mcrl2/symbolic/saturation.h"
 #include "mcrl2/symbolic/symbolic_reachability.h"
 #include "mcrl2/utilities/parse_numbers.h"
 #include "mcrl2/utilities/stack_array.h"
@@ -45,8 +46,15 @@ class lpsreach_algorithm
     template <typename Context, bool ActionLabel>
     friend void symbolic::learn_successors_callback(WorkerP*, Task*, std::uint32_t* v, std::size_t n, void* context);
 
+    template <bool ActionLabel, typename Algorithm, typename Group, typename ReportTransition>
+    friend void symbolic::learn_transitions(Algorithm&, Group&, const data::rewriter&, data::mutable_indexed_substitution<>&, const data::enumerator_algorithm<>&, const std::uint32_t*, std::mutex*, ReportTransition);
+
+    template <bool ActionLabel, typename Algorithm, typename Group>
+    friend void symbolic::learn_successors_parallel(Algorithm&, Group&, const sylvan::ldds::ldd&, const data::data_specification&, std::size_t);
+
   protected:
     const symbolic::symbolic_reachability_options& m_options;
+    data::data_specification m_dataspec;
     data::rewriter m_rewr;
     data::mutable_indexed_substitution<> m_sigma;
     data::enumerator_identifier_generator m_id_generator;
@@ -55,6 +63,7 @@ class lpsreach_algorithm
     std::vector<boost::dynamic_bitset<>> m_group_patterns;
     std::vector<std::size_t> m_variable_order;
     symbolic_lts m_lts;
+    std::unique_ptr<symbolic::saturation_algorithm> m_saturation; // only used if the saturation option is set
     
     /// \brief Rewrites all arguments of the given action.
     template<typename Rewriter, typename Substitution>
@@ -83,6 +92,11 @@ class lpsreach_algorithm
       mCRL2log(log::debug1) << "learn successors of summand group " << i << " for X = " << print_states(m_lts.data_index, X, R.read) << std::endl;
 
       using namespace sylvan::ldds;
+      if (m_options.parallel_learning && lace_workers() > 1)
+      {
+        symbolic::learn_successors_parallel<true>(*this, static_cast<lps_summand_group&>(R), X, m_dataspec, lace_workers());
+        return;
+      }
       std::pair<lpsreach_algorithm&, symbolic::summand_group&> context{*this, R};
       sat_all_nopar(X, symbolic::learn_successors_callback<std::pair<lpsreach_algorithm&, lps_summand_group&>, true>, &context);
     }
@@ -114,6 +128,7 @@ class lpsreach_algorithm
   public:
     lpsreach_algorithm(const lps::specification& lpsspec, const symbolic::symbolic_reachability_options& options_)
       : m_options(options_),
+        m_dataspec(lpsspec.data()),
         m_rewr(symbolic::construct_rewriter(lpsspec.data(), m_options.rewrite_strategy, lps::find_function_symbols(lpsspec), m_options.remove_unused_rewrite_rules)),
         m_enumerator(m_rewr, lpsspec.data(), m_rewr, m_id_generator, false)
     {
@@ -217,47 +232,32 @@ class lpsreach_algorithm
       }
       else
       {
-        // saturation and chaining
-        todo1 = todo;
-        ldd todo1_old; // the old todo set.
-
-        for (std::size_t i = 0; i < R.size(); i++)
+        // saturation
+        if (learn_transitions)
         {
-          if (learn_transitions)
+          for (std::size_t i = 0; i < R.size(); i++)
           {
-            ldd proj = project(todo1, R[i].Ip);
+            ldd proj = project(todo, R[i].Ip);
             learn_successors(i, R[i], m_options.cached ? minus(proj, R[i].Ldomain) : proj);
 
             mCRL2log(log::debug1) << "L =\n" << print_relation(m_lts.data_index, R[i].L, R[i].read, R[i].write) << std::endl;
           }
+        }
 
-          // Apply one transition relation repeatedly.
-          do
-          {
-            todo1_old = todo1;
-            todo1 = union_(todo1, relprod_impl(todo1, R[i], i));
-          }
-          while (todo1 != todo1_old);
-
-          if (detect_deadlocks)
-          {
-            potential_deadlocks = minus(potential_deadlocks, relprev(todo1, R[i].L, R[i].Ir, potential_deadlocks));
-          }
+        if (!m_saturation)
+        {
+          m_saturation = std::make_unique<symbolic::saturation_algorithm>(R);
+        }
+        ldd saturated = m_saturation->run(todo);
 
-          // Apply all previously learned transition relations repeatedly.
-          if (m_options.chaining)
+        if (detect_deadlocks)
+        {
+          for (std::size_t i = 0; i < R.size(); i++)
           {
-            do
-            {
-              todo1_old = todo1;
-              for (std::size_t j = 0; j <= i; j++)
-              {
-                todo1 = union_(todo1, relprod_impl(todo1, R[j], j));
-              }
-            }
-            while (todo1 != todo1_old);
+            potential_deadlocks = minus(potential_deadlocks, relprev(saturated, R[i].L, R[i].Ir, potential_deadlocks));
           }
         }
+        todo1 = minus(saturated, todo);
       }
 
       // after all transition groups are applied the remaining potential deadlocks are actual deadlocks.
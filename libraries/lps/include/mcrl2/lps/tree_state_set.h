@@ -0,0 +1,288 @@
+// Author(s): Wieger Wesselink, Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/tree_state_set.h
+/// \brief A set of states that assigns a unique index to each state, and that
+///        stores the states compactly by means of tree compression.
+
+#ifndef MCRL2_LPS_TREE_STATE_SET_H
+#define MCRL2_LPS_TREE_STATE_SET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "mcrl2/atermpp/standard_containers/indexed_set.h"
+#include "mcrl2/lps/state.h"
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/hash_utility.h"
+
+namespace mcrl2::lps {
+
+/// \brief A set of states of a fixed size that assigns a unique index to each state.
+/// \details The values of the process parameters are stored in a separate set per parameter,
+///          such that a state is a vector of value indices. This vector is stored as a binary tree
+///          with the same shape as the balanced tree of a state, in which every internal node is a
+///          pair of the indices of its children. The pairs are stored in a separate set per node of the
+///          tree. As the states of a state space typically differ in only a few parameters, most of these
+///          pairs are shared between states, and a new state only adds the pairs on the paths to its
+///          new values. The index of a state is the index of the pair at the root of its tree. So, unlike
+///          an indexed set of states, the state terms themselves are not kept alive.
+///          The parts of a successor state that are not changed are shared with the state from which it was
+///          computed. Therefore, every thread caches the indices of the subtrees that it recently looked up,
+///          such that usually only the nodes on the paths to the changed parameters are looked up in the sets.
+///          The thread indices are those of an indexed set: 0 for a sequential set, and 1, ..., n otherwise.
+class tree_state_set
+{
+  public:
+    typedef std::size_t size_type;
+
+    /// \brief Value returned by index when a state does not occur in the set.
+    static constexpr size_type npos = std::numeric_limits<std::size_t>::max();
+
+  protected:
+    // The hash of a pair is computed by mixing the bits, as the indexed set only uses the lower bits of the hash.
+    struct pair_hash
+    {
+      std::size_t operator()(std::uint64_t x) const
+      {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        return static_cast<std::size_t>(x);
+      }
+    };
+
+    typedef atermpp::indexed_set<data::data_expression, atermpp::detail::GlobalThreadSafe> value_set;
+    typedef utilities::indexed_set<std::uint64_t, atermpp::detail::GlobalThreadSafe, pair_hash> pair_set;
+
+    std::size_t m_state_size;
+    std::vector<value_set> m_values;  // The values of each parameter.
+    std::vector<pair_set> m_nodes;    // The pairs of each internal node, indexed by the position of the last leaf of its left subtree.
+
+    struct cache_entry
+    {
+      atermpp::aterm tree;
+      std::size_t position = 0;
+      std::size_t index = 0;
+    };
+
+    // The number of entries of the cache of each thread, which must be a power of two.
+    static constexpr std::size_t cache_size = 1 << 12;
+    std::vector<std::vector<cache_entry>> m_caches;
+
+    // The position in m_nodes of the root of the tree.
+    std::size_t root() const
+    {
+      return m_state_size < 2 ? 0 : ((m_state_size + 1) >> 1) - 1;
+    }
+
+    static std::uint64_t make_pair(std::size_t left, std::size_t right)
+    {
+      if (left > std::numeric_limits<std::uint32_t>::max() || right > std::numeric_limits<std::uint32_t>::max())
+      {
+        throw mcrl2::runtime_error("The number of different values or subvectors of states exceeds the capacity of the state set (2^32).");
+      }
+      return (static_cast<std::uint64_t>(left) << 32) | right;
+    }
+
+    // Puts the pair of the internal node of the tree t that contains the parameters first, ..., first + size - 1 in result.
+    // If Insert is false, it returns false if one of the children does not occur in the set.
+    template <bool Insert>
+    bool make_node(std::uint64_t& result, const atermpp::aterm_appl& t, std::size_t first, std::size_t size, std::size_t thread_index)
+    {
+      assert(size > 1);
+      std::size_t left_size = (size + 1) >> 1;
+      std::size_t left;
+      std::size_t right;
+      if (!make_child<Insert>(left, t[0], first, left_size, thread_index) ||
+          !make_child<Insert>(right, t[1], first + left_size, size - left_size, thread_index))
+      {
+        return false;
+      }
+      result = make_pair(left, right);
+      return true;
+    }
+
+    template <bool Insert>
+    bool make_child(std::size_t& result, const atermpp::aterm& t, std::size_t first, std::size_t size, std::size_t thread_index)
+    {
+      if (size == 1)
+      {
+        const data::data_expression& value = atermpp::down_cast<data::data_expression>(t);
+        result = Insert ? m_values[first].insert(value, thread_index).first : m_values[first].index(value, thread_index);
+        return result != value_set::npos;
+      }
+
+      const std::size_t position = first + ((size + 1) >> 1) - 1;
+      cache_entry& entry = m_caches[thread_index][utilities::detail::hash_combine(std::hash<atermpp::aterm>()(t), position) & (cache_size - 1)];
+      if (entry.tree == t && entry.position == position)
+      {
+        result = entry.index;
+        return true;
+      }
+
+      std::uint64_t node;
+      if (!make_node<Insert>(node, atermpp::down_cast<atermpp::aterm_appl>(t), first, size, thread_index))
+      {
+        return false;
+      }
+      pair_set& nodes = m_nodes[position];
+      result = Insert ? nodes.insert(node, thread_index).first : nodes.index(node, thread_index);
+      if (result == pair_set::npos)
+      {
+        return false;
+      }
+
+      atermpp::detail::shared_guard guard;
+      entry.tree = t;
+      entry.position = position;
+      entry.index = result;
+      return true;
+    }
+
+    // Puts the pair at the root of the tree of s in result.
+    template <bool Insert>
+    bool make_root(std::uint64_t& result, const state& s, std::size_t thread_index)
+    {
+      if (m_state_size == 0)
+      {
+        result = 0;
+        return true;
+      }
+      else if (m_state_size == 1)
+      {
+        std::size_t value;
+        if (!make_child<Insert>(value, s[0], 0, 1, thread_index))
+        {
+          return false;
+        }
+        result = make_pair(value, 0);
+        return true;
+      }
+      return make_node<Insert>(result, s, 0, m_state_size, thread_index);
+    }
+
+    // Adds the values of the node with the given index that contains the parameters first, ..., first + size - 1 to values.
+    void add_values(std::vector<data::data_expression>& values, std::size_t index, std::size_t first, std::size_t size) const
+    {
+      if (size == 1)
+      {
+        values.push_back(m_values[first][index]);
+        return;
+      }
+      std::size_t left_size = (size + 1) >> 1;
+      add_pair_values(values, m_nodes[first + left_size - 1][index], first, size);
+    }
+
+    void add_pair_values(std::vector<data::data_expression>& values, std::uint64_t pair, std::size_t first, std::size_t size) const
+    {
+      std::size_t left_size = (size + 1) >> 1;
+      add_values(values, static_cast<std::size_t>(pair >> 32), first, left_size);
+      add_values(values, static_cast<std::size_t>(pair & std::numeric_limits<std::uint32_t>::max()), first + left_size, size - left_size);
+    }
+
+  public:
+    /// \brief Constructor of an empty set of states.
+    /// \param state_size The number of elements of the states in the set.
+    /// \param number_of_threads The number of threads that use this set, see the indexed set.
+    explicit tree_state_set(std::size_t state_size, std::size_t number_of_threads = 1)
+      : m_state_size(state_size)
+    {
+      m_values.reserve(state_size);
+      for (std::size_t i = 0; i < state_size; i++)
+      {
+        m_values.emplace_back(number_of_threads);
+      }
+      std::size_t number_of_nodes = std::max(state_size, std::size_t(2)) - 1;
+      m_nodes.reserve(number_of_nodes);
+      for (std::size_t i = 0; i < number_of_nodes; i++)
+      {
+        m_nodes.emplace_back(number_of_threads);
+      }
+      m_caches.resize(number_of_threads == 1 ? 1 : number_of_threads + 1, std::vector<cache_entry>(cache_size));
+    }
+
+    /// \brief Returns the number of elements of the states in the set.
+    std::size_t state_size() const
+    {
+      return m_state_size;
+    }
+
+    /// \brief Returns the index of the state s, or npos if s does not occur in the set.
+    /// \threadsafe
+    size_type index(const state& s, std::size_t thread_index = 0) const
+    {
+      assert(s.size() == m_state_size);
+      std::uint64_t node;
+      // Without insertion the lookup of the nodes does not modify the set.
+      if (!const_cast<tree_state_set*>(this)->make_root<false>(node, s, thread_index))
+      {
+        return npos;
+      }
+      return m_nodes[root()].index(node, thread_index);
+    }
+
+    /// \brief Inserts the state s in the set.
+    /// \return The index of s and a boolean indicating whether s was actually inserted.
+    /// \threadsafe
+    std::pair<size_type, bool> insert(const state& s, std::size_t thread_index = 0)
+    {
+      assert(s.size() == m_state_size);
+      std::uint64_t node;
+      make_root<true>(node, s, thread_index);
+      return m_nodes[root()].insert(node, thread_index);
+    }
+
+    /// \brief Returns the state with the given index.
+    /// \details The state is reconstructed from its values. This is not thread safe with respect to insertions.
+    state operator[](size_type index) const
+    {
+      assert(index < size());
+      std::uint64_t node = m_nodes[root()][index];
+      std::vector<data::data_expression> values;
+      values.reserve(m_state_size);
+      if (m_state_size == 1)
+      {
+        add_values(values, static_cast<std::size_t>(node >> 32), 0, 1);
+      }
+      else if (m_state_size > 1)
+      {
+        add_pair_values(values, node, 0, m_state_size);
+      }
+      return state(values.begin(), m_state_size);
+    }
+
+    /// \brief Returns the number of states in the set.
+    /// \threadsafe
+    size_type size(std::size_t thread_index = 0) const
+    {
+      return m_nodes[root()].size(thread_index);
+    }
+
+    /// \brief Removes all states from the set.
+    void clear(std::size_t thread_index = 0)
+    {
+      for (value_set& values: m_values)
+      {
+        values.clear(thread_index);
+      }
+      for (pair_set& nodes: m_nodes)
+      {
+        nodes.clear(thread_index);
+      }
+      for (std::vector<cache_entry>& cache: m_caches)
+      {
+        std::fill(cache.begin(), cache.end(), cache_entry());
+      }
+    }
+};
+
+} // namespace mcrl2::lps
+
+#endif // MCRL2_LPS_TREE_STATE_SET_H
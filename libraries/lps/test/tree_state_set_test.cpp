@@ -0,0 +1,103 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file tree_state_set_test.cpp
+/// \brief Tests for the tree compressed set of states.
+
+#define BOOST_TEST_MODULE tree_state_set_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <thread>
+#include "mcrl2/data/standard_numbers_utility.h"
+#include "mcrl2/lps/tree_state_set.h"
+
+using namespace mcrl2;
+using namespace mcrl2::lps;
+
+static state make_test_state(std::size_t size, std::size_t x)
+{
+  std::vector<data::data_expression> values;
+  for (std::size_t i = 0; i < size; i++)
+  {
+    // The parameters differ in the number of values that they take.
+    values.push_back(data::sort_nat::nat(x % (i + 2)));
+  }
+  return state(values.begin(), size);
+}
+
+static void test_state_size(std::size_t size)
+{
+  tree_state_set states(size);
+  std::size_t number_of_states = size == 0 ? 1 : 1000;
+  std::vector<std::size_t> indices;
+  for (std::size_t x = 0; x < number_of_states; x++)
+  {
+    state s = make_test_state(size, x);
+    std::size_t index = states.index(s);
+    auto [i, inserted] = states.insert(s);
+    BOOST_CHECK_EQUAL(inserted, index == tree_state_set::npos);
+    if (inserted)
+    {
+      BOOST_CHECK_EQUAL(i, indices.size());
+      indices.push_back(x);
+    }
+    BOOST_CHECK_EQUAL(states.index(s), i);
+  }
+
+  BOOST_CHECK_EQUAL(states.size(), indices.size());
+  for (std::size_t i = 0; i < indices.size(); i++)
+  {
+    BOOST_CHECK_EQUAL(states[i], make_test_state(size, indices[i]));
+  }
+
+  states.clear();
+  BOOST_CHECK_EQUAL(states.size(), 0u);
+  BOOST_CHECK_EQUAL(states.index(make_test_state(size, 0)), tree_state_set::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_tree_state_set)
+{
+  for (std::size_t size = 0; size <= 9; size++)
+  {
+    test_state_size(size);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_tree_state_set_threads)
+{
+  const std::size_t number_of_threads = 4;
+  const std::size_t size = 7;
+  tree_state_set states(size, number_of_threads);
+
+  // All threads insert the same states, such that every state obtains a single index.
+  std::vector<std::vector<std::size_t>> indices(number_of_threads + 1, std::vector<std::size_t>(1000));
+  std::vector<std::thread> threads;
+  for (std::size_t t = 1; t <= number_of_threads; t++)
+  {
+    threads.emplace_back([&, t]()
+      {
+        for (std::size_t x = 0; x < 1000; x++)
+        {
+          indices[t][x] = states.insert(make_test_state(size, x), t).first;
+        }
+      });
+  }
+  for (std::thread& thread: threads)
+  {
+    thread.join();
+  }
+
+  for (std::size_t x = 0; x < 1000; x++)
+  {
+    for (std::size_t t = 2; t <= number_of_threads; t++)
+    {
+      BOOST_CHECK_EQUAL(indices[t][x], indices[1][x]);
+    }
+    BOOST_CHECK_EQUAL(states[indices[1][x]], make_test_state(size, x));
+  }
+}
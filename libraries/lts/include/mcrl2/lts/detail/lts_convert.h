@@ -20,6 +20,7 @@
 #define MCRL2_LTS_DETAIL_LTS_CONVERT_H
 
 #include "mcrl2/lts/lts_lts.h"
+#include "mcrl2/lts/lts_bin.h"
 #include "mcrl2/lts/lts_aut.h"
 #include "mcrl2/lts/lts_fsm.h"
 #include "mcrl2/lts/lts_dot.h"
@@ -817,6 +818,38 @@ inline action_label_string lts_convert_translate_label(const action_label_string
 }
 
 
+// ======================  bin -> any and any -> bin  =============================
+
+// The labels and the base class of the indexed binary format are those of the .lts format. Therefore
+// the conversions from and to the .lts format are reused, by letting the convertors for lts_bin_base
+// inherit from the convertors for lts_lts_base. The functions lts_convert_base_class, 
+// lts_convert_translate_label and lts_convert_translate_state for lts_lts_base are selected via
+// the conversion to the base class.
+
+template <class BASE_LTS_OUT>
+class convertor<lts_bin_base, BASE_LTS_OUT>: public convertor<lts_lts_base, BASE_LTS_OUT>
+{
+  public:
+    typedef convertor<lts_lts_base, BASE_LTS_OUT> super;
+    using super::super;
+};
+
+template <class BASE_LTS_IN>
+class convertor<BASE_LTS_IN, lts_bin_base>: public convertor<BASE_LTS_IN, lts_lts_base>
+{
+  public:
+    typedef convertor<BASE_LTS_IN, lts_lts_base> super;
+    using super::super;
+};
+
+template<>
+class convertor<lts_bin_base, lts_bin_base>: public convertor<lts_lts_base, lts_lts_base>
+{
+  public:
+    typedef convertor<lts_lts_base, lts_lts_base> super;
+    using super::super;
+};
+
 // ======================  END CONCRETE LTS FORMAT CONVERSIONS  =============================
 
 
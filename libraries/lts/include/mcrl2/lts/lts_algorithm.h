@@ -30,6 +30,7 @@
 #include "mcrl2/lts/lts_equivalence.h"
 #include "mcrl2/lts/lts_preorder.h"
 #include "mcrl2/lts/sigref.h"
+#include "mcrl2/lts/sigref_parallel.h"
 
 namespace mcrl2
 {
@@ -579,6 +580,12 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
       s.run();
       return;
     }
+    case lts_eq_bisim_sigref_parallel:
+    {
+      sigref_parallel<LTS_TYPE> s(l, false);
+      s.run();
+      return;
+    }
     case lts_eq_branching_bisim:
     {
       detail::bisimulation_reduce_dnj(l,true,false);
@@ -600,6 +607,12 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
       s.run();
       return;
     }
+    case lts_eq_branching_bisim_sigref_parallel:
+    {
+      sigref_parallel<LTS_TYPE> s(l, true);
+      s.run();
+      return;
+    }
     case lts_eq_divergence_preserving_branching_bisim:
     {
       detail::bisimulation_reduce_dnj(l,true,true);
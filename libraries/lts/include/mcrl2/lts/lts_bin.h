@@ -0,0 +1,119 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/** \file lts_bin.h
+ *
+ * \brief This file contains a class that contains labelled transition systems in the
+ *        indexed binary format.
+ * \details The labels of an lts in the indexed binary format are the same as those
+ *        of the .lts format, i.e. multi actions and state vectors. In a file the
+ *        transitions are stored in a fixed width array that can be mapped into memory
+ *        directly, such that huge transition systems can be loaded without decoding
+ *        every transition. The action labels and state labels are stored in separate
+ *        tables after the transitions.
+ */
+
+#ifndef MCRL2_LTS_LTS_BIN_H
+#define MCRL2_LTS_LTS_BIN_H
+
+#include "mcrl2/lts/lts_lts.h"
+
+namespace mcrl2
+{
+namespace lts
+{
+
+namespace detail
+{
+
+/** \brief The header of a file in the indexed binary lts format.
+    \details All fields are stored in the byte order of the machine that wrote the file.
+             The transitions start at transitions_offset and consist of number_of_transitions
+             triples (from, label, to) of 64 bit numbers. The tables with the data specification,
+             the action labels and the state labels start at labels_offset and are stored as a
+             binary aterm stream.
+*/
+struct lts_bin_header
+{
+  char magic[8];
+  std::uint64_t byte_order;
+  std::uint64_t version;
+  std::uint64_t number_of_states;
+  std::uint64_t number_of_action_labels;
+  std::uint64_t number_of_transitions;
+  std::uint64_t initial_state;
+  std::uint64_t has_state_labels;
+  std::uint64_t transitions_offset;
+  std::uint64_t labels_offset;
+};
+
+/** \brief A transition as it is stored in a file in the indexed binary lts format.
+*/
+struct lts_bin_transition
+{
+  std::uint64_t from;
+  std::uint64_t label;
+  std::uint64_t to;
+};
+
+/** \brief A base class for the lts_bin labelled transition system.
+    \details The information in the base class is the same as for the .lts format.
+*/
+class lts_bin_base : public lts_lts_base
+{
+  public:
+    /** \brief Yields the type of this lts, in this case lts_bin. */
+    lts_type type() const
+    {
+      return lts_bin;
+    }
+};
+
+} // namespace detail
+
+/** \brief This class contains labelled transition systems in the indexed binary format.
+    \details An action label is a multi action, and a state label is a list of state vectors,
+             exactly as in the .lts format.
+*/
+class lts_bin_t : public lts< state_label_lts, action_label_lts, detail::lts_bin_base >
+{
+  public:
+    /** \brief Creates an object containing no information. */
+    lts_bin_t() {}
+
+    /** \brief Load the labelled transition system from file.
+     *  \details If the filename is empty, the result is read from stdin. Otherwise the file
+     *           is mapped into memory, if this is supported by the platform.
+     *  \param[in] filename Name of the file from which this lts is read.
+     */
+    void load(const std::string& filename);
+
+    /** \brief Save the labelled transition system to file.
+     *  \details If the filename is empty, the result is written to stdout.
+     *  \param[in] filename Name of the file to which this lts is written.
+     */
+    void save(const std::string& filename) const;
+};
+
+/** \brief Loads an lts in the indexed binary format directly into an lts in .lts format.
+ *  \param[out] result The lts in which the transition system is put.
+ *  \param[in] filename Name of the file from which the lts is read. If empty, stdin is used.
+ */
+void load_lts_bin(lts_lts_t& result, const std::string& filename);
+
+/** \brief Saves an lts in .lts format to a file in the indexed binary format.
+ *  \param[in] l The lts that is saved.
+ *  \param[in] filename Name of the file to which the lts is written. If empty, stdout is used.
+ */
+void save_lts_bin(const lts_lts_t& l, const std::string& filename);
+
+} // namespace lts
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_LTS_BIN_H
@@ -29,7 +29,7 @@ lps::state remove_time_stamp(const lps::state& s)
 
 struct lts_builder
 {
-  typedef atermpp::indexed_set<lps::state, atermpp::detail::GlobalThreadSafe> indexed_set_for_states_type;
+  typedef lps::tree_state_set indexed_set_for_states_type;
   // All LTS classes use integers to represent actions in transitions. A mapping from actions to integers
   // is needed to avoid duplicates.
   utilities::unordered_map_large<lps::multi_action, std::size_t> m_actions;
@@ -115,6 +115,7 @@ class lts_aut_disk_builder: public lts_builder
   protected:
     std::ofstream out;
     std::size_t m_transition_count = 0;
+    std::vector<std::string> m_action_strings; // The printed multi-actions, indexed by the numbers assigned by add_action.
 
   public:
     explicit lts_aut_disk_builder(const std::string& filename)
@@ -127,12 +128,19 @@ class lts_aut_disk_builder: public lts_builder
         std::exit(EXIT_FAILURE);
       }
       out << "des                                                \n"; // write a dummy header that will be overwritten
+      m_action_strings.emplace_back("tau");
     }
 
     void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to) override
     {
       m_transition_count++;
-      out << "(" << from << ",\"" << lps::pp(a) << "\"," << to << ")\n";
+      // Multi-actions are only printed once, as printing is expensive compared to writing a transition.
+      std::size_t label = add_action(a);
+      if (label == m_action_strings.size())
+      {
+        m_action_strings.push_back(lps::pp(a));
+      }
+      out << "(" << from << ",\"" << m_action_strings[label] << "\"," << to << ")\n";
     }
 
     // Add actions and states to the LTS
@@ -217,7 +225,7 @@ class lts_lts_disk_builder: public lts_builder
 {
   protected:
     std::fstream fstream;
-    std::unique_ptr<atermpp::binary_aterm_ostream> stream;
+    std::unique_ptr<atermpp::chunked_binary_aterm_ostream> stream;
     bool m_discard_state_labels = false;
 
   public:
@@ -237,7 +245,7 @@ class lts_lts_disk_builder: public lts_builder
       }
 
       mCRL2log(log::verbose) << "writing state space in LTS format to '" << filename << "'." << std::endl;
-      stream = std::make_unique<atermpp::binary_aterm_ostream>(fstream);
+      stream = std::make_unique<atermpp::chunked_binary_aterm_ostream>(fstream);
 
       mcrl2::lts::write_lts_header(*stream, dataspec, process_parameters, action_labels);
     }
@@ -255,16 +263,14 @@ class lts_lts_disk_builder: public lts_builder
         // Write the state labels in the order of their indices.
         for (std::size_t i = 0; i < state_map.size(); i++)
         {
-          if (is_aterm_balanced_tree(state_map[i]))  // in a parallel context not all positions may be filled.
+          const lps::state s = state_map[i];
+          if (timed)
           {
-            if (timed)
-            {
-              write_state_label(*stream, state_label_lts(remove_time_stamp(state_map[i])));
-            }
-            else
-            {
-              write_state_label(*stream, state_label_lts(state_map[i]));
-            }
+            write_state_label(*stream, state_label_lts(remove_time_stamp(s)));
+          }
+          else
+          {
+            write_state_label(*stream, state_label_lts(s));
           }
         }
       }
@@ -308,6 +314,25 @@ class lts_fsm_builder: public lts_lts_builder
     }
 };
 
+class lts_bin_builder: public lts_lts_builder
+{
+  public:
+    typedef lts_lts_builder super;
+    lts_bin_builder(
+      const data::data_specification& dataspec,
+      const process::action_label_list& action_labels,
+      const data::variable_list& process_parameters,
+      bool discard_state_labels = false
+    )
+      : super(dataspec, action_labels, process_parameters, discard_state_labels)
+    { }
+
+    void save(const std::string& filename) override
+    {
+      save_lts_bin(m_lts, filename);
+    }
+};
+
 inline
 std::unique_ptr<lts_builder> create_lts_builder(const lps::specification& lpsspec, const lps::explorer_options& options, lts_type output_format, const std::string& output_filename = "")
 {
@@ -326,6 +351,7 @@ std::unique_ptr<lts_builder> create_lts_builder(const lps::specification& lpsspe
     }
     case lts_dot: return std::make_unique<lts_dot_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
     case lts_fsm: return std::make_unique<lts_fsm_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
+    case lts_bin: return std::make_unique<lts_bin_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
     case lts_lts:
     {
       if (options.save_at_end)
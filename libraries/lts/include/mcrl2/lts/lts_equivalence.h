@@ -35,10 +35,12 @@ enum lts_equivalence
   lts_eq_bisim_gv,         /**< Strong bisimulation equivalence using the O(mn) algorithm [Groote/Vaandrager 1990] */
   lts_eq_bisim_gjkw,        /**< Strong bisimulation equivalence using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017] */
   lts_eq_bisim_sigref,     /**< Strong bisimulation equivalence using the signature refinement algorithm [Blom/Orzan 2003] */
+  lts_eq_bisim_sigref_parallel, /**< Strong bisimulation equivalence using a multi-threaded signature refinement algorithm [Blom/Orzan 2003] */
   lts_eq_branching_bisim,  /**< Branching bisimulation equivalence using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019] */
   lts_eq_branching_bisim_gv,     /**< Branching bisimulation equivalence using the O(mn) algorithm [Groote/Vaandrager 1990] */
   lts_eq_branching_bisim_gjkw,   /**< Branching bisimulation equivalence using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017 */
   lts_eq_branching_bisim_sigref, /**< Branching bisimulation equivalence using the signature refinement algorithm [Blom/Orzan 2003] */
+  lts_eq_branching_bisim_sigref_parallel, /**< Branching bisimulation equivalence using a multi-threaded signature refinement algorithm [Blom/Orzan 2003] */
   lts_eq_divergence_preserving_branching_bisim, /**< Divergence-preserving branching bisimulation equivalence using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019] */
   lts_eq_divergence_preserving_branching_bisim_gv,    /**< Divergence-preserving branching bisimulation equivalence using the O(mn) algorithm [Groote/Vaandrager 1990] */
   lts_eq_divergence_preserving_branching_bisim_gjkw,   /**< Divergence-preserving branching bisimulation equivalence using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017] */
@@ -63,12 +65,16 @@ enum lts_equivalence
  *          [Groote/Vaandrager 1990];
  * \li "bisim-sig" for strong bisimilarity using the signature refinement
  *          algorithm [Blom/Orzan 2003];
+ * \li "bisim-sig-par" for strong bisimilarity using a multi-threaded signature
+ *          refinement algorithm [Blom/Orzan 2003];
  * \li "branching-bisim" for branching bisimilarity using the O(m log n)
  *          algorithm [Groote/Jansen/Keiren/Wijs 2017];
  * \li "branching-bisim-gv" for branching bisimilarity using the O(mn)
  *          algorithm [Groote/Vaandrager 1990];
  * \li "branching-bisim-sig" for branching bisimilarity using the signature
  *          refinement algorithm [Blom/Orzan 2003];
+ * \li "branching-bisim-sig-par" for branching bisimilarity using a multi-threaded
+ *          signature refinement algorithm [Blom/Orzan 2003];
  * \li "dpbranching-bisim" for divergence-preserving branching bisimilarity
  *          using the O(m log n) algorithm [Groote/Jansen/Keiren/Wijs 2017];
  * \li "dpbranching-bisim-gv" for divergence-preserving branching bisimilarity
@@ -108,6 +114,10 @@ lts_equivalence parse_equivalence(std::string const& s)
   {
     return lts_eq_bisim_sigref;
   }
+  else if (s == "bisim-sig-par")
+  {
+    return lts_eq_bisim_sigref_parallel;
+  }
   else if (s == "branching-bisim")
   {
     return lts_eq_branching_bisim;
@@ -124,6 +134,10 @@ lts_equivalence parse_equivalence(std::string const& s)
   {
     return lts_eq_branching_bisim_sigref;
   }
+  else if (s == "branching-bisim-sig-par")
+  {
+    return lts_eq_branching_bisim_sigref_parallel;
+  }
   else if (s == "dpbranching-bisim")
   {
     return lts_eq_divergence_preserving_branching_bisim;
@@ -218,6 +232,8 @@ inline std::string print_equivalence(const lts_equivalence eq)
       return "bisim-gjkw";
     case lts_eq_bisim_sigref:
       return "bisim-sig";
+    case lts_eq_bisim_sigref_parallel:
+      return "bisim-sig-par";
     case lts_eq_branching_bisim:
       return "branching-bisim";
     case lts_eq_branching_bisim_gv:
@@ -226,6 +242,8 @@ inline std::string print_equivalence(const lts_equivalence eq)
       return "branching-bisim-gjkw";
     case lts_eq_branching_bisim_sigref:
       return "branching-bisim-sig";
+    case lts_eq_branching_bisim_sigref_parallel:
+      return "branching-bisim-sig-par";
     case lts_eq_divergence_preserving_branching_bisim:
       return "dpbranching-bisim";
     case lts_eq_divergence_preserving_branching_bisim_gv:
@@ -283,6 +301,8 @@ inline std::string description(const lts_equivalence eq)
       return "strong bisimilarity using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017]";
     case lts_eq_bisim_sigref:
       return "strong bisimilarity using the signature refinement algorithm [Blom/Orzan 2003]";
+    case lts_eq_bisim_sigref_parallel:
+      return "strong bisimilarity using a multi-threaded signature refinement algorithm [Blom/Orzan 2003]";
     case lts_eq_branching_bisim:
       return "branching bisimilarity using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019]";
     case lts_eq_branching_bisim_gv:
@@ -291,6 +311,8 @@ inline std::string description(const lts_equivalence eq)
       return "branching bisimilarity using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017]";
     case lts_eq_branching_bisim_sigref:
       return "branching bisimilarity using the signature refinement algorithm [Blom/Orzan 2003]";
+    case lts_eq_branching_bisim_sigref_parallel:
+      return "branching bisimilarity using a multi-threaded signature refinement algorithm [Blom/Orzan 2003]";
     case lts_eq_divergence_preserving_branching_bisim:
       return "divergence-preserving branching bisimilarity using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019]";
     case lts_eq_divergence_preserving_branching_bisim_gv:
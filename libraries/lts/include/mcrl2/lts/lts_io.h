@@ -49,6 +49,7 @@ lts_type guess_format(std::string const& s, const bool be_verbose=true);
  * \li "aut" for the Ald&eacute;baran format;
  * \li "fsm" for the FSM format;
  * \li "dot" for the GraphViz format;
+ * \li "bin" for the mCRL2 indexed binary format;
  *
  * \param[in] s The format specification string.
  * \return The LTS format based on the value of \a s.
@@ -188,14 +189,14 @@ inline void convert_to_lts_lts(LTS_TYPE& src,
 } //  namespace detail
 
 /** \brief Loads an lts of the indicated type, transforms it to an lts of the form lts_lts_t using the additional data parameters.
- *  \details The file can refer to any file in lts, aut, fsm, or dot
+ *  \details The file can refer to any file in lts, bin, aut, fsm, or dot
  *           format. After reading it is is translated into .lts format. For this 
  *           a file is read with the name extra_data_file, which is interpreted 
  *           as a data specification if extra_data_file_type has type data_e, a linear process specification
  *           if it has value lps_e, and an mcrl2 file if it has value mcrl2_e.
  *  \param[out] result The lts in which the transition system is put. 
  *  \param[in] infilename The name of the file containing the lts.
- *  \param[in] type The type of the lts file, i.e. .lts, .fsm, .dot or .aut.
+ *  \param[in] type The type of the lts file, i.e. .lts, .bin, .fsm, .dot or .aut.
  *  \param[in] extra_data_file_type The type of the file containing extra information, such as a data specification.
  *  \param[in] extra_data_file_name The name of the file containing extra information. */
 inline void load_lts(lts_lts_t& result, 
@@ -215,6 +216,15 @@ inline void load_lts(lts_lts_t& result,
       result.load(infilename);
       break;
     }
+    case lts_bin:
+    {
+      if (extra_data_file_type != none_e)
+      {
+        mCRL2log(log::warning) << "The lts file comes with a data specification. Ignoring the extra data and action label specification provided." << std::endl;
+      }
+      load_lts_bin(result, infilename);
+      break;
+    }
     case lts_none:
       mCRL2log(log::warning) << "Cannot determine type of input. Assuming .aut.\n";
       [[fallthrough]]; // For the default (lts_none) load as aut file.
@@ -258,6 +268,13 @@ inline void load_lts_as_fsm_file(const std::string& path, lts_fsm_t& l)
       detail::lts_convert(l1,l);
       return;
     }
+    case lts_bin:
+    {
+      lts_bin_t l1;
+      l1.load(path);
+      detail::lts_convert(l1,l);
+      return;
+    }
     case lts_none:
       mCRL2log(log::warning) << "Cannot determine type of input. Assuming .aut.\n";
       [[fallthrough]]; // For the default (lts_none) load as aut file.
@@ -40,8 +40,9 @@ enum lts_type
   lts_aut,                   /**< Ald&eacute;baran format (CADP) */
   lts_fsm,                   /**< FSM format */
   lts_dot,                   /**< GraphViz format */
+  lts_bin,                   /**< mCRL2 indexed binary format */
   lts_type_min=lts_none,
-  lts_type_max=lts_dot
+  lts_type_max=lts_bin
 };
 
 }
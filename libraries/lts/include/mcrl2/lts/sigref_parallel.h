@@ -0,0 +1,418 @@
+// Author(s): Jeroen Keiren
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file sigref_parallel.h
+/// \brief Multi-threaded implementation of LTS reductions using the signature
+///        refinement approach of S. Blom and S. Orzan.
+
+#ifndef MCRL2_LTS_SIGREF_PARALLEL_H
+#define MCRL2_LTS_SIGREF_PARALLEL_H
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "mcrl2/lts/detail/liblts_scc.h"
+#include "mcrl2/utilities/detail/parallel_for.h"
+#include "mcrl2/utilities/hash_utility.h"
+
+namespace mcrl2
+{
+namespace lts
+{
+
+/** \brief Multi-threaded signature based reductions for strong and branching bisimulation.
+  *
+  * The algorithm is the signature refinement algorithm of S. Blom, S. Orzan.
+  * "Distributed Branching Bisimulation Reduction of State Spaces", in Proc. PDMC 2003,
+  * see also sigref.h. In every iteration the signatures of all states are computed
+  * in parallel, after which the pairs of the old block and the signature of each state are
+  * inserted in parallel into a hash table that is split into independently locked shards.
+  * The new block numbers are assigned in the order of the smallest state in each block, such
+  * that the result does not depend on the number of threads.
+  *
+  * For branching bisimulation the tau-cycles are removed first. The states are then divided
+  * in layers, such that the tau-successors of a state are in a lower layer. The signatures
+  * of the states in one layer only depend on the signatures of the states in lower layers,
+  * so the layers are handled one by one, and the states within a layer in parallel.
+  */
+template < class LTS_T >
+class sigref_parallel
+{
+protected:
+  /** \brief A signature is a sorted vector of pairs of an action label and a block */
+  typedef std::vector<std::pair<std::size_t, std::size_t> > signature_type;
+
+  /** \brief The key under which a state is stored in the hash table; the old block of the state and its signature */
+  struct block_key
+  {
+    std::size_t hash;
+    std::size_t block;
+    const signature_type* signature;
+
+    bool operator==(const block_key& other) const
+    {
+      return block == other.block && *signature == *other.signature;
+    }
+  };
+
+  struct block_key_hash
+  {
+    std::size_t operator()(const block_key& key) const
+    {
+      return key.hash;
+    }
+  };
+
+  /** \brief A part of the hash table with its own lock. For each new block the
+             smallest state in it is recorded. */
+  struct shard
+  {
+    std::mutex mutex;
+    std::unordered_map<block_key, std::size_t, block_key_hash> blocks;
+    std::vector<std::size_t> smallest_state;
+    std::vector<std::size_t> block_number;
+  };
+
+  /** \brief The LTS that we are reducing */
+  LTS_T& m_lts;
+
+  /** \brief Whether branching bisimulation is used instead of strong bisimulation */
+  const bool m_branching;
+
+  /** \brief The number of threads that is used */
+  std::size_t m_number_of_threads;
+
+  /** \brief Current partition; for each state the block in which it resides is recorded. */
+  std::vector<std::size_t> m_partition;
+
+  /** \brief The number of blocks in the current partition */
+  std::size_t m_count;
+
+  /** \brief The outgoing transitions of state s are at positions m_first[s] up to m_first[s+1]
+             of m_label and m_target. Hidden labels are replaced by tau. */
+  std::vector<std::size_t> m_first;
+  std::vector<std::size_t> m_label;
+  std::vector<std::size_t> m_target;
+
+  /** \brief The states divided in layers, such that a tau-successor of a state is in a lower
+             layer. For strong bisimulation there is only one layer. */
+  std::vector<std::vector<std::size_t> > m_layers;
+
+  /** \brief Signature stored per state */
+  std::vector<signature_type> m_sig;
+
+  /** \brief The hash table, and for each state the shard and the position in the shard of its new block */
+  std::vector<shard> m_shards;
+  std::vector<std::pair<std::size_t, std::size_t> > m_block_of_state;
+
+  bool is_inert(std::size_t s, std::size_t i) const
+  {
+    return m_branching && m_lts.is_tau(m_label[i]) && m_partition[s] == m_partition[m_target[i]];
+  }
+
+  /** \brief Store the outgoing transitions per state, and compute the layers. */
+  void initialise()
+  {
+    const std::size_t n = m_lts.num_states();
+    m_first.assign(n + 1, 0);
+    for (const transition& t: m_lts.get_transitions())
+    {
+      m_first[t.from() + 1]++;
+    }
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      m_first[s + 1] += m_first[s];
+    }
+    std::vector<std::size_t> position(m_first.begin(), m_first.end() - 1);
+    m_label.resize(m_lts.num_transitions());
+    m_target.resize(m_lts.num_transitions());
+    for (const transition& t: m_lts.get_transitions())
+    {
+      const std::size_t i = position[t.from()]++;
+      m_label[i] = m_lts.apply_hidden_label_map(t.label());
+      m_target[i] = t.to();
+    }
+
+    m_layers.clear();
+    if (!m_branching)
+    {
+      m_layers.emplace_back(n);
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        m_layers[0][s] = s;
+      }
+      return;
+    }
+
+    // Compute the layers using the tau-transitions backwards, starting in the states
+    // without tau-successors. Tau-loops are ignored, and other tau-cycles have been removed.
+    std::vector<std::size_t> remaining(n, 0);
+    std::vector<std::size_t> first_pred(n + 1, 0);
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      for (std::size_t i = m_first[s]; i < m_first[s + 1]; ++i)
+      {
+        if (m_lts.is_tau(m_label[i]) && m_target[i] != s)
+        {
+          remaining[s]++;
+          first_pred[m_target[i] + 1]++;
+        }
+      }
+    }
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      first_pred[s + 1] += first_pred[s];
+    }
+    std::vector<std::size_t> pred(first_pred[n]);
+    position.assign(first_pred.begin(), first_pred.end() - 1);
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      for (std::size_t i = m_first[s]; i < m_first[s + 1]; ++i)
+      {
+        if (m_lts.is_tau(m_label[i]) && m_target[i] != s)
+        {
+          pred[position[m_target[i]]++] = s;
+        }
+      }
+    }
+
+    std::vector<std::size_t> layer;
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      if (remaining[s] == 0)
+      {
+        layer.push_back(s);
+      }
+    }
+    std::size_t visited = 0;
+    while (!layer.empty())
+    {
+      visited += layer.size();
+      std::vector<std::size_t> next_layer;
+      for (std::size_t s: layer)
+      {
+        for (std::size_t i = first_pred[s]; i < first_pred[s + 1]; ++i)
+        {
+          if (--remaining[pred[i]] == 0)
+          {
+            next_layer.push_back(pred[i]);
+          }
+        }
+      }
+      m_layers.push_back(std::move(layer));
+      layer = std::move(next_layer);
+    }
+    if (visited != n)
+    {
+      throw mcrl2::runtime_error("The transition system contains a tau-cycle, which should have been removed before the parallel signature refinement.");
+    }
+  }
+
+  /** \brief Compute the signature of state s based on the current partition. */
+  void compute_signature(std::size_t s)
+  {
+    signature_type& sig = m_sig[s];
+    sig.clear();
+    for (std::size_t i = m_first[s]; i < m_first[s + 1]; ++i)
+    {
+      if (is_inert(s, i))
+      {
+        // The signature of an inert tau-successor is part of the signature of s. As the
+        // successor is in a lower layer, its signature has already been computed.
+        if (m_target[i] != s)
+        {
+          const signature_type& succ = m_sig[m_target[i]];
+          sig.insert(sig.end(), succ.begin(), succ.end());
+        }
+      }
+      else
+      {
+        sig.emplace_back(m_label[i], m_partition[m_target[i]]);
+      }
+    }
+    std::sort(sig.begin(), sig.end());
+    sig.erase(std::unique(sig.begin(), sig.end()), sig.end());
+  }
+
+  /** \brief Compute a new partition from the signatures. */
+  void renumber_blocks()
+  {
+    const std::size_t n = m_lts.num_states();
+    for (shard& sh: m_shards)
+    {
+      sh.blocks.clear();
+      sh.smallest_state.clear();
+    }
+
+    utilities::detail::parallel_for(m_number_of_threads, n, [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t s = begin; s < end; ++s)
+      {
+        std::size_t hash = std::hash<std::size_t>()(m_partition[s]);
+        for (const std::pair<std::size_t, std::size_t>& p: m_sig[s])
+        {
+          hash = utilities::detail::hash_combine(hash, utilities::detail::hash_combine(p.first, p.second));
+        }
+
+        const std::size_t index = (hash >> 16) % m_shards.size();
+        shard& sh = m_shards[index];
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        auto i = sh.blocks.emplace(block_key{hash, m_partition[s], &m_sig[s]}, sh.smallest_state.size());
+        if (i.second)
+        {
+          sh.smallest_state.push_back(s);
+        }
+        else
+        {
+          sh.smallest_state[i.first->second] = std::min(sh.smallest_state[i.first->second], s);
+        }
+        m_block_of_state[s] = std::make_pair(index, i.first->second);
+      }
+    });
+
+    // Number the blocks in the order of their smallest state.
+    for (shard& sh: m_shards)
+    {
+      sh.block_number.resize(sh.smallest_state.size());
+    }
+    m_count = 0;
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      shard& sh = m_shards[m_block_of_state[s].first];
+      if (sh.smallest_state[m_block_of_state[s].second] == s)
+      {
+        sh.block_number[m_block_of_state[s].second] = m_count++;
+      }
+    }
+
+    utilities::detail::parallel_for(m_number_of_threads, n, [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t s = begin; s < end; ++s)
+      {
+        m_partition[s] = m_shards[m_block_of_state[s].first].block_number[m_block_of_state[s].second];
+      }
+    });
+  }
+
+  /** \brief Compute the partition. Repeatedly updates the signatures, and
+             the partition, until the partition stabilises */
+  void compute_partition()
+  {
+    std::size_t count_prev;
+    std::size_t iterations = 0;
+    do
+    {
+      mCRL2log(log::verbose, "sigref") << "Iteration " << iterations
+                                       << " currently have " << m_count << " blocks" << std::endl;
+
+      for (const std::vector<std::size_t>& layer: m_layers)
+      {
+        utilities::detail::parallel_for(m_number_of_threads, layer.size(), [&](std::size_t begin, std::size_t end)
+        {
+          for (std::size_t i = begin; i < end; ++i)
+          {
+            compute_signature(layer[i]);
+          }
+        });
+      }
+
+      count_prev = m_count;
+      renumber_blocks();
+      ++iterations;
+    }
+    while (count_prev != m_count);
+
+    mCRL2log(log::verbose, "sigref") << "Done after " << iterations << " iterations with " << m_count << " blocks" << std::endl;
+  }
+
+  /** \brief Perform the quotient with respect to the partition that has
+             been computed */
+  void quotient()
+  {
+    // Every thread removes the duplicates from its own transitions, after which the
+    // remaining duplicates are removed when the transitions are added to the LTS.
+    std::vector<transition> result;
+    std::mutex mutex;
+    utilities::detail::parallel_for(m_number_of_threads, m_lts.num_states(), [&](std::size_t begin, std::size_t end)
+    {
+      std::vector<transition> transitions;
+      for (std::size_t s = begin; s < end; ++s)
+      {
+        for (std::size_t i = m_first[s]; i < m_first[s + 1]; ++i)
+        {
+          if (!is_inert(s, i))
+          {
+            transitions.emplace_back(m_partition[s], m_label[i], m_partition[m_target[i]]);
+          }
+        }
+      }
+      std::sort(transitions.begin(), transitions.end());
+      transitions.erase(std::unique(transitions.begin(), transitions.end()), transitions.end());
+
+      std::lock_guard<std::mutex> lock(mutex);
+      result.insert(result.end(), transitions.begin(), transitions.end());
+    });
+    std::sort(result.begin(), result.end());
+
+    // Assign the reduced LTS
+    m_lts.set_num_states(m_count);
+    m_lts.set_initial_state(m_partition[m_lts.initial_state()]);
+    m_lts.clear_transitions();
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+      if (i == 0 || result[i - 1] != result[i])
+      {
+        m_lts.add_transition(result[i]);
+      }
+    }
+  }
+
+public:
+  /** \brief Constructor
+    * \param[in] lts_ The LTS that is being reduced
+    * \param[in] branching If true, branching bisimulation is used, and otherwise strong bisimulation.
+    * \param[in] number_of_threads The number of threads, where 0 means the number of hardware threads.
+    */
+  sigref_parallel(LTS_T& lts_, bool branching, std::size_t number_of_threads = 0)
+    : m_lts(lts_),
+      m_branching(branching),
+      m_number_of_threads(number_of_threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : number_of_threads),
+      m_count(0)
+  {}
+
+  /** \brief Perform the reduction */
+  void run()
+  {
+    // No need for state labels in the reduced LTS.
+    m_lts.clear_state_labels();
+    if (m_branching)
+    {
+      scc_reduce(m_lts);
+    }
+
+    mCRL2log(log::verbose, "sigref") << "initialising parallel signature computation for "
+                                     << (m_branching ? "branching" : "strong") << " bisimulation using "
+                                     << m_number_of_threads << " threads" << std::endl;
+
+    m_partition.assign(m_lts.num_states(), 0);
+    m_count = m_lts.num_states() > 0 ? 1 : 0;
+    m_sig.assign(m_lts.num_states(), signature_type());
+    m_block_of_state.resize(m_lts.num_states());
+    m_shards = std::vector<shard>(16 * m_number_of_threads);
+
+    initialise();
+    compute_partition();
+    quotient();
+  }
+};
+
+} // namespace lts
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_SIGREF_PARALLEL_H
@@ -20,7 +20,7 @@ namespace lts {
 
 struct stochastic_lts_builder
 {
-  typedef atermpp::indexed_set<lps::state, atermpp::detail::GlobalThreadSafe> indexed_set_for_states_type;
+  typedef lps::tree_state_set indexed_set_for_states_type;
   // All LTS classes use integers to represent actions in transitions. A mapping from actions to integers
   // is needed to avoid duplicates.
   utilities::unordered_map_large<lps::multi_action, std::size_t> m_actions;
@@ -296,6 +296,7 @@ std::unique_ptr<stochastic_lts_builder> create_stochastic_lts_builder(const lps:
     case lts_aut: return std::make_unique<stochastic_lts_aut_builder>();
     case lts_lts: return std::make_unique<stochastic_lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
     case lts_fsm: return std::make_unique<stochastic_lts_fsm_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
+    case lts_bin: throw mcrl2::runtime_error("The indexed binary format cannot contain probabilistic transition systems.");
     default: return std::make_unique<stochastic_lts_none_builder>();
   }
 }
@@ -445,6 +445,13 @@ void lps2lts_algorithm::finalise_lts_generation()
         fsm.save(m_options.lts);
         break;
       }
+      case lts_bin:
+      {
+        lts_bin_t bin;
+        detail::lts_convert(m_output_lts, bin);
+        bin.save(m_options.lts);
+        break;
+      }
       case lts_dot:
       {
         probabilistic_lts_dot_t dot;
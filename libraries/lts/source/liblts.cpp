@@ -63,14 +63,22 @@ lts_type guess_format(std::string const& s, const bool be_verbose/*=true*/)
       }
       return lts_dot;
     }
+    else if (ext == "bin")
+    {
+      if (be_verbose)
+      {
+        mCRL2log(verbose) << "Detected mCRL2 indexed binary extension.\n";
+      }
+      return lts_bin;
+    }
   }
 
   return lts_none;
 }
 
-static const std::string type_strings[] = { "unknown", "lts", "aut", "fsm", "dot" };
+static const std::string type_strings[] = { "unknown", "lts", "aut", "fsm", "dot", "bin" };
 
-static const std::string extension_strings[] = { "", "lts", "aut", "fsm", "dot" };
+static const std::string extension_strings[] = { "", "lts", "aut", "fsm", "dot", "bin" };
 
 static std::string type_desc_strings[] = {
     "unknown LTS format",
@@ -78,7 +86,7 @@ static std::string type_desc_strings[] = {
     "Aldebaran format (CADP)",
     "Finite State Machine format",
     "GraphViz format (no longer supported as input format)",
-    "SVC format"
+    "mCRL2 indexed binary format, which can be loaded without decoding every transition"
                                          };
 
 
@@ -86,7 +94,8 @@ static std::string mime_type_strings[] = { "",
     "application/lts",
     "text/aut",
     "text/fsm",
-    "text/dot"
+    "text/dot",
+    "application/lts-bin"
                                          };
 
 lts_type parse_format(std::string const& s)
@@ -107,6 +116,10 @@ lts_type parse_format(std::string const& s)
   {
     return lts_dot;
   }
+  else if (s == "bin")
+  {
+    return lts_bin;
+  }
   return lts_none;
 }
 
@@ -8,7 +8,14 @@
 //
 /// \file liblts_aut.cpp
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <exception>
 #include <fstream>
+#include <thread>
+#include <unordered_map>
 #include "mcrl2/utilities/unordered_map.h"
 #include "mcrl2/lts/lts_aut.h"
 #include "mcrl2/lts/detail/liblts_swap_to_from_probabilistic_lts.h"
@@ -472,6 +479,375 @@ static void read_from_aut(lts_aut_t& l, std::istream& is)
 }
 
 
+// ====================== Parallel reading and writing of .aut files =============================
+//
+// Large .aut files without probabilistic states are read in blocks. Every block is split at line
+// boundaries into one chunk per thread, and the chunks are parsed in parallel. Each thread stores
+// the transitions of its chunk with labels that are numbered locally, in the order in which they
+// occur in the chunk. Afterwards the chunks are merged in order, which gives exactly the same
+// numbering of the action labels as reading the file sequentially. Writing is done in a similar
+// way: blocks of transitions are formatted in parallel, and written in order.
+
+// The number of threads that is used for reading and writing .aut files.
+static std::size_t number_of_aut_threads()
+{
+  return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+// The number of bytes that is parsed by one thread in one block.
+static const std::size_t aut_chunk_size = 1 << 24;
+
+// The number of transitions that is formatted by one thread in one block.
+static const std::size_t aut_write_chunk_size = 1 << 18;
+
+// Applies f to 0, ..., n-1 in parallel, where f(0) is executed by the calling thread.
+// If f throws an exception for some index, the first of these is rethrown.
+template <typename Function>
+static void aut_parallel_for(std::size_t n, Function f)
+{
+  std::vector<std::exception_ptr> exceptions(n);
+  auto run = [&](std::size_t i)
+  {
+    try
+    {
+      f(i);
+    }
+    catch (...)
+    {
+      exceptions[i] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < n; ++i)
+  {
+    threads.emplace_back(run, i);
+  }
+  run(0);
+  for (std::thread& t: threads)
+  {
+    t.join();
+  }
+
+  for (const std::exception_ptr& e: exceptions)
+  {
+    if (e)
+    {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+// The transitions of one chunk, where the label of each transition is an index in labels.
+struct aut_chunk
+{
+  std::vector<transition> transitions;
+  std::vector<std::string> labels;
+  std::unordered_map<std::string, std::size_t> label_indices;
+  std::size_t newlines = 0;               // The number of newlines in the chunk.
+  bool end_of_transitions = false;        // An EOT character was encountered.
+  std::string error;                      // A non empty error message indicates a parse error,
+  std::size_t error_line = 0;             // at the given line relative to the start of the chunk.
+
+  void clear()
+  {
+    transitions.clear();
+    labels.clear();
+    label_indices.clear();
+    newlines = 0;
+    end_of_transitions = false;
+    error.clear();
+  }
+};
+
+// A parser for the transitions in the range [first, last) that does not use streams.
+class aut_chunk_parser
+{
+  protected:
+    const char* m_current;
+    const char* m_last;
+    aut_chunk& m_chunk;
+    std::string m_label;
+
+    bool at_end() const
+    {
+      return m_current == m_last;
+    }
+
+    // Skips spaces, tabs and carriage returns, but not newlines.
+    void skip_spaces()
+    {
+      while (!at_end() && (*m_current == ' ' || *m_current == '\t' || *m_current == '\r'))
+      {
+        ++m_current;
+      }
+    }
+
+    // Skips all white space including newlines, which are counted.
+    void skip_white_space()
+    {
+      for (; !at_end() && std::isspace(static_cast<unsigned char>(*m_current)); ++m_current)
+      {
+        if (*m_current == '\n')
+        {
+          m_chunk.newlines++;
+        }
+      }
+    }
+
+    bool expect(char ch)
+    {
+      skip_spaces();
+      if (at_end() || *m_current != ch)
+      {
+        return false;
+      }
+      ++m_current;
+      return true;
+    }
+
+    bool read_number(std::size_t& result)
+    {
+      skip_spaces();
+      auto [ptr, ec] = std::from_chars(m_current, m_last, result);
+      if (ec != std::errc() || ptr == m_current)
+      {
+        return false;
+      }
+      m_current = ptr;
+      return true;
+    }
+
+    // Reads a label, which is either quoted, in which case white space is preserved, or
+    // consists of all non white space characters up to the next comma.
+    bool read_label()
+    {
+      m_label.clear();
+      skip_spaces();
+      if (!at_end() && *m_current == '"')
+      {
+        ++m_current;
+        const char* end = std::find(m_current, m_last, '"');
+        if (end == m_last)
+        {
+          return false;
+        }
+        m_label.assign(m_current, end);
+        m_current = end + 1;
+        return true;
+      }
+      for (; !at_end() && *m_current != ','; ++m_current)
+      {
+        if (!std::isspace(static_cast<unsigned char>(*m_current)))
+        {
+          m_label.push_back(*m_current);
+        }
+      }
+      return !m_label.empty();
+    }
+
+    std::size_t label_index()
+    {
+      auto [i, inserted] = m_chunk.label_indices.try_emplace(m_label, m_chunk.labels.size());
+      if (inserted)
+      {
+        m_chunk.labels.push_back(m_label);
+      }
+      return i->second;
+    }
+
+    void error(const std::string& message)
+    {
+      m_chunk.error = message;
+      m_chunk.error_line = m_chunk.newlines;
+    }
+
+  public:
+    aut_chunk_parser(const char* first, const char* last, aut_chunk& chunk)
+      : m_current(first), m_last(last), m_chunk(chunk)
+    {}
+
+    void run(std::size_t number_of_states)
+    {
+      while (true)
+      {
+        skip_white_space();
+        if (at_end())
+        {
+          return;
+        }
+        if (*m_current == 0x04) // found EOT character that separates two files
+        {
+          m_chunk.end_of_transitions = true;
+          return;
+        }
+
+        std::size_t from;
+        std::size_t to;
+        if (!expect('('))
+        {
+          return error("Expect an opening bracket '(' at the start of the transition");
+        }
+        if (!read_number(from))
+        {
+          return error("Expect a number");
+        }
+        if (!expect(','))
+        {
+          return error("Expect that the first number is followed by a comma");
+        }
+        if (!read_label())
+        {
+          return error("Expect that the second item is a label");
+        }
+        if (!expect(','))
+        {
+          return error("Expect a comma after the quoted label");
+        }
+        if (!read_number(to))
+        {
+          return error("Expect a state number");
+        }
+        if (!expect(')'))
+        {
+          return error("Expect a closing bracket at the end of the transition");
+        }
+        skip_spaces();
+        if (!at_end() && *m_current != '\n')
+        {
+          return error("Expect a newline after the transition");
+        }
+        for (std::size_t state: { from, to })
+        {
+          if (state >= number_of_states)
+          {
+            return error("The state number " + std::to_string(state) + " is higher than the number of states (" +
+                         std::to_string(number_of_states) + ")");
+          }
+        }
+        m_chunk.transitions.emplace_back(from, label_index(), to);
+      }
+    }
+};
+
+// Reads the transitions of a .aut file in parallel, after the header has been read.
+static void read_aut_transitions_in_parallel(lts_aut_t& l, std::istream& is, std::size_t number_of_states)
+{
+  const std::size_t number_of_threads = number_of_aut_threads();
+  std::vector<aut_chunk> chunks(number_of_threads);
+  std::vector<char> buffer;
+  std::size_t leftover = 0;      // The number of bytes of an incomplete line at the start of the buffer.
+  std::size_t line_no = 1;       // The number of lines before the buffer.
+
+  mcrl2::utilities::unordered_map < action_label_string, std::size_t > action_labels;
+  action_labels[action_label_string::tau_action()]=0; // A tau action is always stored at position 0.
+  std::vector<std::size_t> global_label_index;
+
+  bool end_of_transitions = false;
+  while (!end_of_transitions && (leftover > 0 || is.good()))
+  {
+    buffer.resize(leftover + number_of_threads * aut_chunk_size);
+    is.read(buffer.data() + leftover, number_of_threads * aut_chunk_size);
+    std::size_t size = leftover + static_cast<std::size_t>(is.gcount());
+    if (size == 0)
+    {
+      break;
+    }
+
+    // Only complete lines are parsed, unless the end of the input has been reached.
+    std::size_t end = size;
+    if (is.good())
+    {
+      while (end > 0 && buffer[end - 1] != '\n')
+      {
+        --end;
+      }
+      if (end == 0)
+      {
+        // A single line does not fit in the buffer; read more before parsing.
+        leftover = size;
+        continue;
+      }
+    }
+
+    // Split [0, end) into chunks that end at a newline.
+    std::vector<std::size_t> boundaries(number_of_threads + 1, end);
+    boundaries[0] = 0;
+    for (std::size_t i = 1; i < number_of_threads; ++i)
+    {
+      std::size_t position = std::max(boundaries[i - 1], i * (end / number_of_threads));
+      const char* newline = std::find(buffer.data() + position, buffer.data() + end, '\n');
+      boundaries[i] = std::min(end, static_cast<std::size_t>(newline - buffer.data()) + 1);
+    }
+
+    aut_parallel_for(number_of_threads, [&](std::size_t i)
+    {
+      chunks[i].clear();
+      aut_chunk_parser(buffer.data() + boundaries[i], buffer.data() + boundaries[i + 1], chunks[i]).run(number_of_states);
+    });
+
+    // Merge the chunks in order.
+    for (aut_chunk& chunk: chunks)
+    {
+      if (!chunk.error.empty())
+      {
+        throw mcrl2::runtime_error(chunk.error + " at line " + std::to_string(line_no + chunk.error_line + 1) + ".");
+      }
+      global_label_index.clear();
+      for (const std::string& label: chunk.labels)
+      {
+        global_label_index.push_back(find_label_index(label, action_labels, l));
+      }
+      for (const transition& t: chunk.transitions)
+      {
+        l.add_transition(transition(t.from(), global_label_index[t.label()], t.to()));
+      }
+      line_no += chunk.newlines;
+      if (chunk.end_of_transitions)
+      {
+        end_of_transitions = true;
+        break;
+      }
+    }
+
+    // Move the incomplete last line to the front of the buffer.
+    leftover = size - end;
+    std::memmove(buffer.data(), buffer.data() + end, leftover);
+  }
+}
+
+static void read_from_aut_in_parallel(lts_aut_t& l, std::istream& is)
+{
+  std::size_t ntrans=0, nstate=0;
+
+  mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t initial_probabilistic_state;
+  read_aut_header(is,initial_probabilistic_state,ntrans,nstate);
+
+  if (initial_probabilistic_state.size()>1)
+  {
+    throw mcrl2::runtime_error("Encountered an initial probability distribution while reading an non probabilistic .aut file.");
+  }
+
+  check_states(initial_probabilistic_state, nstate, 1);
+
+  if (nstate==0)
+  {
+    throw mcrl2::runtime_error("cannot parse AUT input that has no states; at least an initial state is required.");
+  }
+
+  l.set_num_states(nstate,false);
+  l.clear_transitions(ntrans); // Reserve enough space for the transitions.
+  l.set_initial_state(initial_probabilistic_state.begin()->state());
+
+  read_aut_transitions_in_parallel(l, is, nstate);
+
+  if (ntrans != l.num_transitions())
+  {
+    throw mcrl2::runtime_error("number of transitions read (" + std::to_string(l.num_transitions()) +
+                               ") does not correspond to the number of transition given in the header (" + std::to_string(ntrans) + ").");
+  }
+}
+
 static void write_probabilistic_state(const mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& prob_state, std::ostream& os)
 {
   mcrl2::lts::probabilistic_arbitrary_precision_fraction previous_probability;
@@ -508,16 +884,53 @@ static void write_to_aut(const probabilistic_lts_aut_t& l, std::ostream& os)
   }
 }
 
+static void append_number(std::string& s, std::size_t n)
+{
+  char buffer[24];
+  auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), n);
+  assert(ec == std::errc());
+  (void)ec; // Avoid unused variable warning.
+  s.append(buffer, ptr);
+}
+
 static void write_to_aut(const lts_aut_t& l, std::ostream& os)
 {
   // Do not use "endl" below to avoid flushing. Use "\n" instead.
   os << "des (" << l.initial_state() << "," << l.num_transitions() << "," << l.num_states() << ")" << "\n"; 
 
-  for (const transition& t: l.get_transitions())
+  // The labels are printed once, including the quotes and the surrounding commas.
+  std::vector<std::string> labels;
+  for (std::size_t i = 0; i < l.num_action_labels(); ++i)
   {
-    os << "(" << t.from() << ",\"" 
-       << pp(l.action_label(l.apply_hidden_label_map(t.label()))) << "\"," 
-       << t.to() << ")" << "\n";
+    labels.push_back(",\"" + pp(l.action_label(l.apply_hidden_label_map(i))) + "\",");
+  }
+
+  const std::vector<transition>& transitions = l.get_transitions();
+  const std::size_t number_of_threads = transitions.size() > aut_write_chunk_size ? number_of_aut_threads() : 1;
+  std::vector<std::string> blocks(number_of_threads);
+  for (std::size_t first = 0; first < transitions.size(); first += number_of_threads * aut_write_chunk_size)
+  {
+    aut_parallel_for(number_of_threads, [&](std::size_t i)
+    {
+      std::string& block = blocks[i];
+      block.clear();
+      std::size_t begin = std::min(transitions.size(), first + i * aut_write_chunk_size);
+      std::size_t end = std::min(transitions.size(), begin + aut_write_chunk_size);
+      for (std::size_t j = begin; j < end; ++j)
+      {
+        const transition& t = transitions[j];
+        block.push_back('(');
+        append_number(block, t.from());
+        block.append(labels[t.label()]);
+        append_number(block, t.to());
+        block.append(")\n");
+      }
+    });
+
+    for (const std::string& block: blocks)
+    {
+      os.write(block.data(), block.size());
+    }
   }
 }
 
@@ -579,14 +992,14 @@ void lts_aut_t::load(const std::string& filename)
   }
   else
   {
-    std::ifstream is(filename.c_str());
+    std::ifstream is(filename.c_str(), std::ifstream::in | std::ifstream::binary);
 
     if (!is.is_open())
     {
       throw mcrl2::runtime_error("cannot open .aut file '" + filename + ".");
     }
 
-    read_from_aut(*this,is);
+    read_from_aut_in_parallel(*this,is);
     is.close();
   }
 }
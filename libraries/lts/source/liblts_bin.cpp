@@ -0,0 +1,388 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file liblts_bin.cpp
+
+#include "mcrl2/lts/lts_bin.h"
+#include "mcrl2/lts/lts_io.h"
+#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/utilities/platform.h"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <streambuf>
+
+#if defined(MCRL2_PLATFORM_LINUX) || defined(MCRL2_PLATFORM_MAC) || defined(MCRL2_PLATFORM_FREEBSD)
+#define MCRL2_LTS_BIN_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mcrl2::lts
+{
+
+namespace detail
+{
+
+static const char lts_bin_magic[8] = { 'm', 'C', 'R', 'L', '2', 'B', 'I', 'N' };
+static const std::uint64_t lts_bin_byte_order = 0x0102030405060708;
+static const std::uint64_t lts_bin_version = 1;
+
+/// \brief The number of transitions that is read at once if the file cannot be mapped into memory.
+static const std::size_t lts_bin_block_size = 1 << 16;
+
+static_assert(sizeof(lts_bin_header) == 80, "The header of the indexed binary lts format must not contain padding.");
+static_assert(sizeof(lts_bin_transition) == 24, "A transition in the indexed binary lts format must not contain padding.");
+
+/// \brief A read only stream buffer for a block of memory, used to read the label tables of a mapped file.
+class memory_streambuf : public std::streambuf
+{
+  public:
+    memory_streambuf(const char* begin, const char* end)
+    {
+      char* first = const_cast<char*>(begin);
+      setg(first, first, const_cast<char*>(end));
+    }
+};
+
+#ifdef MCRL2_LTS_BIN_USE_MMAP
+/// \brief A file that is mapped into memory for reading, which is unmapped upon destruction.
+class mapped_file
+{
+  protected:
+    void* m_data = MAP_FAILED;
+    std::size_t m_size = 0;
+
+  public:
+    explicit mapped_file(const std::string& filename)
+    {
+      int fd = ::open(filename.c_str(), O_RDONLY);
+      if (fd < 0)
+      {
+        throw mcrl2::runtime_error("Fail to open file " + filename + " to read an lts.");
+      }
+
+      struct stat status;
+      if (::fstat(fd, &status) == 0 && status.st_size > 0)
+      {
+        m_size = static_cast<std::size_t>(status.st_size);
+        m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      }
+      ::close(fd);
+
+      if (m_data == MAP_FAILED)
+      {
+        throw mcrl2::runtime_error("Fail to map the file " + filename + " into memory.");
+      }
+      ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file()
+    {
+      if (m_data != MAP_FAILED)
+      {
+        ::munmap(m_data, m_size);
+      }
+    }
+
+    const char* data() const
+    {
+      return static_cast<const char*>(m_data);
+    }
+
+    std::size_t size() const
+    {
+      return m_size;
+    }
+};
+#endif // MCRL2_LTS_BIN_USE_MMAP
+
+static void check_header(const lts_bin_header& header, std::size_t file_size = std::numeric_limits<std::size_t>::max())
+{
+  if (std::memcmp(header.magic, lts_bin_magic, sizeof(lts_bin_magic)) != 0)
+  {
+    throw mcrl2::runtime_error("Stream does not contain a labelled transition system in the indexed binary format.");
+  }
+  if (header.byte_order != lts_bin_byte_order)
+  {
+    throw mcrl2::runtime_error("The labelled transition system was written on a machine with a different byte order.");
+  }
+  if (header.version != lts_bin_version)
+  {
+    throw mcrl2::runtime_error("Unsupported version " + std::to_string(header.version) + " of the indexed binary lts format.");
+  }
+  if (header.number_of_states == 0 || header.initial_state >= header.number_of_states || header.number_of_action_labels == 0)
+  {
+    throw mcrl2::runtime_error("The header of the labelled transition system is inconsistent.");
+  }
+  if (header.transitions_offset != sizeof(lts_bin_header) ||
+      header.labels_offset != header.transitions_offset + header.number_of_transitions * sizeof(lts_bin_transition) ||
+      header.labels_offset > file_size)
+  {
+    throw mcrl2::runtime_error("The labelled transition system is truncated or its offsets are inconsistent.");
+  }
+}
+
+template <class LTS>
+static void add_transitions(LTS& lts, const lts_bin_header& header, const lts_bin_transition* first, const lts_bin_transition* last)
+{
+  std::vector<transition>& transitions = lts.get_transitions();
+  for (; first != last; ++first)
+  {
+    if (first->from >= header.number_of_states || first->to >= header.number_of_states || first->label >= header.number_of_action_labels)
+    {
+      throw mcrl2::runtime_error("Transition " + std::to_string(transitions.size()) + " refers to a non existing state or action label.");
+    }
+    transitions.emplace_back(first->from, first->label, first->to);
+  }
+}
+
+// Reads the data specification, the action labels and the state labels.
+template <class LTS>
+static void read_labels(atermpp::aterm_istream& stream, LTS& lts, const lts_bin_header& header)
+{
+  atermpp::aterm_stream_state state(stream);
+  stream >> data::detail::add_index_impl;
+
+  data::data_specification spec;
+  data::variable_list parameters;
+  process::action_label_list action_labels;
+
+  stream >> spec;
+  stream >> parameters;
+  stream >> action_labels;
+
+  lts.set_data(spec);
+  lts.set_process_parameters(parameters);
+  lts.set_action_label_declarations(action_labels);
+
+  // The label with index 0 is tau, which is not stored.
+  for (std::size_t i = 1; i < header.number_of_action_labels; ++i)
+  {
+    action_label_lts label;
+    stream >> label;
+    std::size_t index = lts.add_action(label);
+    if (index != i)
+    {
+      throw mcrl2::runtime_error("The action labels of the labelled transition system are not unique.");
+    }
+  }
+
+  lts.set_num_states(header.number_of_states, header.has_state_labels != 0);
+  if (header.has_state_labels != 0)
+  {
+    for (std::size_t i = 0; i < header.number_of_states; ++i)
+    {
+      state_label_lts label;
+      stream >> label;
+      lts.set_state_label(i, label);
+    }
+  }
+  lts.set_initial_state(header.initial_state);
+}
+
+template <class LTS>
+static void read_from_stream(std::istream& is, LTS& lts)
+{
+  lts_bin_header header;
+  if (!is.read(reinterpret_cast<char*>(&header), sizeof(header)))
+  {
+    throw mcrl2::runtime_error("Stream does not contain a labelled transition system in the indexed binary format.");
+  }
+  check_header(header);
+
+  lts.get_transitions().reserve(header.number_of_transitions);
+  std::vector<lts_bin_transition> block(std::min<std::uint64_t>(lts_bin_block_size, header.number_of_transitions));
+  for (std::uint64_t remaining = header.number_of_transitions; remaining > 0; )
+  {
+    std::size_t n = std::min<std::uint64_t>(remaining, block.size());
+    if (!is.read(reinterpret_cast<char*>(block.data()), n * sizeof(lts_bin_transition)))
+    {
+      throw mcrl2::runtime_error("The labelled transition system is truncated.");
+    }
+    add_transitions(lts, header, block.data(), block.data() + n);
+    remaining -= n;
+  }
+
+  atermpp::binary_aterm_istream stream(is);
+  read_labels(stream, lts, header);
+}
+
+#ifdef MCRL2_LTS_BIN_USE_MMAP
+template <class LTS>
+static void read_from_mapped_file(const std::string& filename, LTS& lts)
+{
+  mapped_file file(filename);
+  if (file.size() < sizeof(lts_bin_header))
+  {
+    throw mcrl2::runtime_error("Stream does not contain a labelled transition system in the indexed binary format.");
+  }
+
+  lts_bin_header header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  check_header(header, file.size());
+
+  // The transitions are used directly from the mapped memory, without any decoding.
+  const lts_bin_transition* transitions = reinterpret_cast<const lts_bin_transition*>(file.data() + header.transitions_offset);
+  lts.get_transitions().reserve(header.number_of_transitions);
+  add_transitions(lts, header, transitions, transitions + header.number_of_transitions);
+
+  memory_streambuf buffer(file.data() + header.labels_offset, file.data() + file.size());
+  std::istream is(&buffer);
+  atermpp::binary_aterm_istream stream(is);
+  read_labels(stream, lts, header);
+}
+#endif // MCRL2_LTS_BIN_USE_MMAP
+
+template <class LTS>
+static void read_from_bin(LTS& lts, const std::string& filename)
+{
+  lts.clear();
+  try
+  {
+    if (filename.empty())
+    {
+      read_from_stream(std::cin, lts);
+    }
+    else
+    {
+#ifdef MCRL2_LTS_BIN_USE_MMAP
+      read_from_mapped_file(filename, lts);
+#else
+      std::ifstream fstream(filename, std::ifstream::in | std::ifstream::binary);
+      if (fstream.fail())
+      {
+        throw mcrl2::runtime_error("Fail to open file " + filename + " to read an lts.");
+      }
+      read_from_stream(fstream, lts);
+#endif
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    mCRL2log(log::error) << ex.what() << "\n";
+    if (filename.empty())
+    {
+      throw mcrl2::runtime_error("Fail to correctly read an lts from standard input.");
+    }
+    else
+    {
+      throw mcrl2::runtime_error("Fail to correctly read an lts from the file " + filename + ".");
+    }
+  }
+}
+
+template <class LTS>
+static void write_to_stream(std::ostream& os, const LTS& lts)
+{
+  lts_bin_header header;
+  std::memcpy(header.magic, lts_bin_magic, sizeof(lts_bin_magic));
+  header.byte_order = lts_bin_byte_order;
+  header.version = lts_bin_version;
+  header.number_of_states = lts.num_states();
+  header.number_of_action_labels = lts.num_action_labels();
+  header.number_of_transitions = lts.num_transitions();
+  header.initial_state = lts.initial_state();
+  header.has_state_labels = lts.has_state_info() ? 1 : 0;
+  header.transitions_offset = sizeof(lts_bin_header);
+  header.labels_offset = header.transitions_offset + header.number_of_transitions * sizeof(lts_bin_transition);
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  std::vector<lts_bin_transition> block;
+  block.reserve(std::min<std::size_t>(lts_bin_block_size, lts.num_transitions()));
+  for (const transition& t: lts.get_transitions())
+  {
+    block.push_back(lts_bin_transition{ t.from(), lts.apply_hidden_label_map(t.label()), t.to() });
+    if (block.size() == lts_bin_block_size)
+    {
+      os.write(reinterpret_cast<const char*>(block.data()), block.size() * sizeof(lts_bin_transition));
+      block.clear();
+    }
+  }
+  os.write(reinterpret_cast<const char*>(block.data()), block.size() * sizeof(lts_bin_transition));
+
+  atermpp::binary_aterm_ostream stream(os);
+  stream << data::detail::remove_index_impl;
+  stream << lts.data();
+  stream << lts.process_parameters();
+  stream << lts.action_label_declarations();
+  for (std::size_t i = 1; i < lts.num_action_labels(); ++i)
+  {
+    stream << lts.action_label(i);
+  }
+  if (lts.has_state_info())
+  {
+    for (std::size_t i = 0; i < lts.num_states(); ++i)
+    {
+      stream << lts.state_label(i);
+    }
+  }
+}
+
+template <class LTS>
+static void write_to_bin(const LTS& lts, const std::string& filename)
+{
+  if (lts.num_states() == 0)
+  {
+    throw mcrl2::runtime_error("Cannot save an lts without states in the indexed binary format.");
+  }
+
+  std::ofstream fstream;
+  if (!filename.empty())
+  {
+    fstream.open(filename, std::ofstream::out | std::ofstream::binary);
+    if (fstream.fail())
+    {
+      throw mcrl2::runtime_error("Fail to open file " + filename + " for writing.");
+    }
+  }
+
+  try
+  {
+    write_to_stream(filename.empty() ? std::cout : fstream, lts);
+  }
+  catch (const std::exception& ex)
+  {
+    mCRL2log(log::error) << ex.what() << "\n";
+    throw mcrl2::runtime_error("Fail to write lts correctly to the file " + filename + ".");
+  }
+}
+
+} // namespace detail
+
+void lts_bin_t::load(const std::string& filename)
+{
+  mCRL2log(log::verbose) << "Starting to load an lts in indexed binary format from the file " << filename << ".\n";
+  detail::read_from_bin(*this, filename);
+}
+
+void lts_bin_t::save(const std::string& filename) const
+{
+  mCRL2log(log::verbose) << "Starting to save an lts in indexed binary format to the file " << filename << ".\n";
+  detail::write_to_bin(*this, filename);
+}
+
+void load_lts_bin(lts_lts_t& result, const std::string& filename)
+{
+  mCRL2log(log::verbose) << "Starting to load an lts in indexed binary format from the file " << filename << ".\n";
+  detail::read_from_bin(result, filename);
+}
+
+void save_lts_bin(const lts_lts_t& l, const std::string& filename)
+{
+  mCRL2log(log::verbose) << "Starting to save an lts in indexed binary format to the file " << filename << ".\n";
+  detail::write_to_bin(l, filename);
+}
+
+} // namespace mcrl2::lts
@@ -23,6 +23,7 @@
 #include "mcrl2/lts/detail/liblts_bisim_gjkw.h"
 #include "mcrl2/lts/detail/coroutine.h"
 #include "mcrl2/lts/lts_aut.h"
+#include "mcrl2/lts/lts_bin.h"
 #include "mcrl2/lts/lts_fsm.h"
 #include "mcrl2/lts/lts_utilities.h"
 
@@ -3251,12 +3252,14 @@ namespace bisim_gjkw
 template class bisim_partitioner_gjkw_initialise_helper<lts_lts_t>;
 template class bisim_partitioner_gjkw_initialise_helper<lts_aut_t>;
 template class bisim_partitioner_gjkw_initialise_helper<lts_fsm_t>;
+template class bisim_partitioner_gjkw_initialise_helper<lts_bin_t>;
 
 } // end namespace bisim_gjkw
 
 template class bisim_partitioner_gjkw<lts_lts_t>;
 template class bisim_partitioner_gjkw<lts_aut_t>;
 template class bisim_partitioner_gjkw<lts_fsm_t>;
+template class bisim_partitioner_gjkw<lts_bin_t>;
 
 } // end namespace detail
 } // end namespace lts
@@ -381,7 +381,7 @@ static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& fi
 
   try
   {
-    atermpp::binary_aterm_ostream stream(filename.empty() ? std::cout : fstream);
+    atermpp::chunked_binary_aterm_ostream stream(filename.empty() ? std::cout : fstream);
     stream << lts;
   }
   catch (const std::exception& ex)
@@ -42,6 +42,7 @@ std::string file_extension(lts::lts_type output_format)
     case lts::lts_aut: return ".aut";
     case lts::lts_fsm: return ".fsm";
     case lts::lts_dot: return ".dot";
+    case lts::lts_bin: return ".bin";
     default: throw mcrl2::runtime_error("unsupported format");
   }
 }
@@ -173,6 +174,7 @@ static void check_lps2lts_specification(const std::string& specification,
         check_lts<lts::lts_aut_t>("AUT", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action);
         check_lts<lts::lts_lts_t>("LTS", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action);
         check_lts<lts::lts_fsm_t>("FSM", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action);
+        check_lts<lts::lts_bin_t>("BIN", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action);
       }
     }
   }
@@ -715,3 +717,37 @@ BOOST_AUTO_TEST_CASE(test_whether_action_a_b_and_b_a_are_the_same)   // Related
 }
 
 
+
+// Check that the exploration with multiple threads, which uses a queue of states per thread and a
+// shared enumeration cache, finds the same state space.
+BOOST_AUTO_TEST_CASE(test_multiple_threads)
+{
+  std::string spec(
+    "act a: Nat;\n"
+    "proc P(n: Nat, m: Nat) = (n < 20) -> a(n).P(n = n + 1)\n"
+    "                       + (m < 15) -> a(m).P(m = m + 1);\n"
+    "init P(0, 0);\n"
+  );
+  lps::specification lpsspec = lps::parse_linear_process_specification(spec);
+
+  for (lps::exploration_strategy estrategy: { lps::es_breadth, lps::es_depth, lps::es_highway })
+  for (bool cached: { false, true })
+  {
+    lps::explorer_options options;
+    options.search_strategy = estrategy;
+    options.number_of_threads = 4;
+    options.save_at_end = true;
+    options.cached = cached;
+    options.cache_size = 8; // Forces that cache entries are removed.
+
+    auto builder = create_lts_builder(lpsspec, options, lts::lts_aut);
+    std::string outputfile = "test_multiple_threads.aut";
+    generate_state_space<false, false>(lpsspec, *builder, outputfile, options);
+
+    lts::lts_aut_t result;
+    result.load(outputfile);
+    BOOST_CHECK_EQUAL(result.num_states(), 21 * 16);
+    BOOST_CHECK_EQUAL(result.num_transitions(), 20 * 16 + 21 * 15);
+    std::remove(outputfile.c_str());
+  }
+}
@@ -81,6 +81,9 @@ static void reduce_lts_in_various_ways(const std::string& test_description,
   reduce(l,lts::lts_eq_bisim_sigref);
   test_lts(test_description + " (bisimulation signature [Blom/Orzan 2003])",l, expected.labels_bisimulation,expected.states_bisimulation, expected.transitions_bisimulation);
   l=l_in;
+  reduce(l,lts::lts_eq_bisim_sigref_parallel);
+  test_lts(test_description + " (bisimulation parallel signature [Blom/Orzan 2003])",l, expected.labels_bisimulation,expected.states_bisimulation, expected.transitions_bisimulation);
+  l=l_in;
   reduce(l,lts::lts_eq_branching_bisim);
   test_lts(test_description + " (branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation);
   l=l_in;
@@ -93,6 +96,9 @@ static void reduce_lts_in_various_ways(const std::string& test_description,
   reduce(l,lts::lts_eq_branching_bisim_sigref);
   test_lts(test_description + " (branching bisimulation signature [Blom/Orzan 2003])",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation);
   l=l_in;
+  reduce(l,lts::lts_eq_branching_bisim_sigref_parallel);
+  test_lts(test_description + " (branching bisimulation parallel signature [Blom/Orzan 2003])",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation);
+  l=l_in;
   reduce(l,lts::lts_eq_divergence_preserving_branching_bisim);
   test_lts(test_description + " (divergence-preserving branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l,
                                       expected.labels_divergence_preserving_branching_bisimulation,
@@ -936,3 +942,116 @@ BOOST_AUTO_TEST_CASE(hide_actions4)
   test_lts("regression test for GJKW bug (branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l,expected_label_count, expected_state_count, expected_transition_count);
 }
 
+
+// Reading an .aut file from disk is done in parallel. Check that this gives the same
+// result as reading it from a stream, and that writing it gives the original file.
+BOOST_AUTO_TEST_CASE(aut_file_read_write_test)
+{
+  std::string automaton =
+     "des (1,6,4)\n"
+     "(0,\"a(1, 2)\",1)\n"
+     "(1,b,2)  \r\n"
+     "\n"
+     "(2,\"tau\",3)\n"
+     "( 3 , \"c|b\" , 0 )\n"
+     "(3,\"b|c\",1)\n"
+     "(1,\"a(1, 2)\",0)";
+
+  std::istringstream is(automaton);
+  lts::lts_aut_t l1;
+  l1.load(is);
+
+  const std::string filename = "aut_file_read_write_test.aut";
+  {
+    std::ofstream os(filename);
+    os << automaton;
+  }
+  lts::lts_aut_t l2;
+  l2.load(filename);
+
+  BOOST_CHECK_EQUAL(l1.num_states(), l2.num_states());
+  BOOST_CHECK_EQUAL(l1.initial_state(), l2.initial_state());
+  BOOST_CHECK(l1.action_labels() == l2.action_labels());
+  BOOST_REQUIRE_EQUAL(l1.num_transitions(), l2.num_transitions());
+  for (std::size_t i = 0; i < l1.num_transitions(); ++i)
+  {
+    const lts::transition& t1 = l1.get_transitions()[i];
+    const lts::transition& t2 = l2.get_transitions()[i];
+    BOOST_CHECK(t1.from() == t2.from() && t1.label() == t2.label() && t1.to() == t2.to());
+  }
+
+  l2.save(filename);
+  std::ifstream saved(filename);
+  std::string text((std::istreambuf_iterator<char>(saved)), std::istreambuf_iterator<char>());
+  BOOST_CHECK_EQUAL(text,
+     "des (1,6,4)\n"
+     "(0,\"a(1, 2)\",1)\n"
+     "(1,\"b\",2)\n"
+     "(2,\"tau\",3)\n"
+     "(3,\"b|c\",0)\n"
+     "(3,\"b|c\",1)\n"
+     "(1,\"a(1, 2)\",0)\n");
+  saved.close();
+  std::remove(filename.c_str());
+
+  const std::string wrong_filename = "aut_file_read_write_test_wrong.aut";
+  {
+    std::ofstream os(wrong_filename);
+    os << "des (0,2,2)\n(0,\"a\",1)\n(1,\"a\" 0)\n";
+  }
+  lts::lts_aut_t l3;
+  BOOST_CHECK_THROW(l3.load(wrong_filename), mcrl2::runtime_error);
+  std::remove(wrong_filename.c_str());
+}
+
+// The transition systems above are too small to be divided over several threads by
+// the parallel signature refinement. Compare it with the default algorithms on a
+// larger transition system with tau-transitions.
+BOOST_AUTO_TEST_CASE(parallel_signature_refinement_test)
+{
+  // The states s and s + half are bisimilar, as their transitions have the same labels,
+  // and targets that are equal modulo half.
+  const std::size_t half = 1000;
+  const std::size_t number_of_states = 2 * half;
+  std::vector<std::string> transitions;
+  for (std::size_t s = 0; s < number_of_states; ++s)
+  {
+    const std::size_t b = s % half;
+    const std::size_t copy = (s / 3) % 2 == 0 ? 0 : half;
+    transitions.push_back("(" + std::to_string(s) + ",\"a" + std::to_string(b % 2) + "\"," + std::to_string((b * 7 + 3) % half + copy) + ")");
+    if (b % 3 == 0)
+    {
+      transitions.push_back("(" + std::to_string(s) + ",\"b\"," + std::to_string((b * 13 + 1) % half + half - copy) + ")");
+    }
+    if (b % 4 != 0 && b + 1 + b % 5 < half)
+    {
+      transitions.push_back("(" + std::to_string(s) + ",\"tau\"," + std::to_string(b + 1 + b % 5 + copy) + ")");
+    }
+  }
+  std::ostringstream automaton;
+  automaton << "des (0," << transitions.size() << "," << number_of_states << ")\n";
+  for (const std::string& t: transitions)
+  {
+    automaton << t << "\n";
+  }
+
+  std::istringstream is(automaton.str());
+  lts::lts_aut_t l_in;
+  l_in.load(is);
+
+  lts::lts_aut_t l1 = l_in;
+  reduce(l1, lts::lts_eq_bisim);
+  lts::lts_aut_t l2 = l_in;
+  lts::sigref_parallel<lts::lts_aut_t>(l2, false, 4).run();
+  test_lts("parallel signature refinement (bisimulation)", l2, l1.num_action_labels(), l1.num_states(), l1.num_transitions());
+  BOOST_CHECK(compare(l1, l2, lts::lts_eq_bisim));
+
+  // Hiding a1 introduces tau-cycles.
+  l_in.record_hidden_actions(std::vector<std::string>(1, "a1"));
+  l1 = l_in;
+  reduce(l1, lts::lts_eq_branching_bisim);
+  l2 = l_in;
+  lts::sigref_parallel<lts::lts_aut_t>(l2, true, 4).run();
+  test_lts("parallel signature refinement (branching bisimulation)", l2, l1.num_action_labels(), l1.num_states(), l1.num_transitions());
+  BOOST_CHECK(compare(l1, l2, lts::lts_eq_branching_bisim));
+}
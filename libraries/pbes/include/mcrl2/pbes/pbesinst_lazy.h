@@ -9,6 +9,8 @@
 /// \file mcrl2/pbes/pbesinst_lazy_algorithm.h
 /// \brief A lazy algorithm for instantiating a PBES, ported from bes_deprecated.h.
 
+#include <atomic>
+#include <condition_variable>
 #include <thread>
 #include <mutex>
 #include <shared_mutex>
@@ -16,6 +18,7 @@
 
 #include "mcrl2/atermpp/standard_containers/deque.h"
 #include "mcrl2/atermpp/standard_containers/indexed_set.h"
+#include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/data/substitution_utility.h"
 #include "mcrl2/pbes/detail/bes_equation_limit.h"
 #include "mcrl2/pbes/detail/instantiate_global_variables.h"
@@ -28,6 +31,7 @@
 #include "mcrl2/pbes/rewriters/simplify_quantifiers_rewriter.h"
 #include "mcrl2/pbes/transformation_strategy.h"
 #include "mcrl2/pbes/transformations.h"
+#include "mcrl2/utilities/detail/work_stealing_todo_set.h"
 
 #ifndef MCRL2_PBES_PBESINST_LAZY_H
 #define MCRL2_PBES_PBESINST_LAZY_H
@@ -180,6 +184,9 @@ std::ostream& operator<<(std::ostream& out, const pbesinst_lazy_todo& todo)
   return out << "todo = " << core::detail::print_list(todo.elements()) << " irrelevant = " << core::detail::print_list(todo.irrelevant_elements()) << std::endl;
 }
 
+/// \brief Per thread queues of the propositional variable instantiations that need to be handled.
+typedef utilities::detail::work_stealing_todo_set<propositional_variable_instantiation, atermpp::deque<propositional_variable_instantiation>> pbesinst_lazy_work_stealing_todo;
+
 /// \brief A PBES instantiation algorithm that uses a lazy strategy
 class pbesinst_lazy_algorithm
 {
@@ -216,7 +223,13 @@ class pbesinst_lazy_algorithm
     std::mutex m_todo_access;
     std::shared_mutex m_graph_access;
 
-    volatile bool m_must_abort = false;
+    /// \brief Signals that elements were added to todo, or that a thread finished an element.
+    std::condition_variable m_todo_changed;
+
+    /// \brief The number of threads that are processing an element taken from todo.
+    std::size_t m_busy_threads = 0;
+
+    std::atomic<bool> m_must_abort{false};
 
     // \brief Returns a status message about the progress
     virtual std::string status_message(std::size_t equation_count)
@@ -317,14 +330,15 @@ class pbesinst_lazy_algorithm
 
     /// \brief Reports BES equations that are produced by the algorithm.
     /// This function is called for every BES equation X = psi with rank k that is produced. By default it does nothing.
+    /// It is called with exclusive access to the graph, i.e., while m_graph_access is locked.
     virtual void on_report_equation(const std::size_t /* thread_index */,
-                                    std::shared_mutex& /* realloc_mutex */,
                                     const propositional_variable_instantiation& /* X */,
                                     const pbes_expression& /* psi */, std::size_t /* k */
                                    )
     { }
 
     /// \brief This function is called when new elements are added to discovered.
+    /// It is called with exclusive access to the graph.
     virtual void on_discovered_elements(const std::set<propositional_variable_instantiation>& /* elements */)
     { }
 
@@ -374,54 +388,77 @@ class pbesinst_lazy_algorithm
       return false;
     }
 
+    /// \brief Returns true if the algorithm inspects or modifies the todo list while instantiating,
+    /// such that all threads must take their work from a single todo list.
+    virtual bool requires_shared_todo() const
+    {
+      return false;
+    }
+
+    // Computes the right hand side psi_e of the BES equation for X_e.
+    void instantiate_equation(const std::size_t thread_index,
+                              const propositional_variable_instantiation& X_e,
+                              pbes_expression& psi_e,
+                              data::mutable_indexed_substitution<>& sigma,
+                              enumerate_quantifiers_rewriter& R
+                             )
+    {
+      std::size_t index = m_equation_index.index(X_e.name());
+      const pbes_equation& eqn = m_pbes.equations()[index];
+      const auto& phi = eqn.formula();
+      data::add_assignments(sigma, eqn.variable().parameters(), X_e.parameters());
+      R(psi_e, phi, sigma);
+      R.clear_identifier_generator();
+      data::remove_assignments(sigma, eqn.variable().parameters());
+
+      // optional step
+      std::shared_lock<std::shared_mutex> graph_lock(m_graph_access);
+      rewrite_psi(thread_index, psi_e, eqn.symbol(), X_e, psi_e);
+    }
+
+    // Processes the elements of the todo list that is shared by all threads. A thread that finds
+    // the todo list empty waits until another thread adds elements to it, and stops as soon as
+    // no thread is busy anymore.
     virtual void run_thread(const std::size_t thread_index,
                             pbesinst_lazy_todo& todo,
-                            std::atomic<std::size_t>& number_of_active_processes,
                             data::mutable_indexed_substitution<> sigma,
                             enumerate_quantifiers_rewriter R
                            )
     {
-      using utilities::detail::contains;
-
       if (m_options.number_of_threads>1) mCRL2log(log::debug) << "Start thread " << thread_index << ".\n";
       R.thread_initialise();
 
       propositional_variable_instantiation X_e;
       pbes_expression psi_e;
 
-      while (number_of_active_processes > 0)
+      std::unique_lock<std::mutex> todo_lock(m_todo_access);
+      while (true)
       {
-        m_todo_access.lock();
-        while (!todo.elements().empty() && !m_must_abort)
+        m_todo_changed.wait(todo_lock, [&]() { return !todo.elements().empty() || m_busy_threads == 0 || m_must_abort; });
+        if (todo.elements().empty() || m_must_abort)
         {
-          ++m_iteration_count;
-          mCRL2log(log::status) << status_message(m_iteration_count);
-          detail::check_bes_equation_limit(m_iteration_count);
-
-          next_todo(X_e);
-          m_todo_access.unlock();
+          break;
+        }
 
-          std::size_t index = m_equation_index.index(X_e.name());
-          const pbes_equation& eqn = m_pbes.equations()[index];
-          const auto& phi = eqn.formula();
-          data::add_assignments(sigma, eqn.variable().parameters(), X_e.parameters());
-          R(psi_e, phi, sigma);
-          R.clear_identifier_generator();
-          data::remove_assignments(sigma, eqn.variable().parameters());
+        ++m_iteration_count;
+        mCRL2log(log::status) << status_message(m_iteration_count);
+        detail::check_bes_equation_limit(m_iteration_count);
 
-          // optional step
-          m_graph_access.lock_shared();
-          rewrite_psi(thread_index, psi_e, eqn.symbol(), X_e, psi_e);
-          m_graph_access.unlock_shared();
+        next_todo(X_e);
+        m_busy_threads++;
+        todo_lock.unlock();
 
-          std::set<propositional_variable_instantiation> occ = find_propositional_variable_instantiations(psi_e);
+        instantiate_equation(thread_index, X_e, psi_e, sigma, R);
+        std::set<propositional_variable_instantiation> occ = find_propositional_variable_instantiations(psi_e);
 
-          // report the generated equation
-          std::size_t k = m_equation_index.rank(X_e.name());
-          m_todo_access.lock();
+        // report the generated equation
+        std::size_t k = m_equation_index.rank(X_e.name());
+        todo_lock.lock();
+        {
+          std::unique_lock<std::shared_mutex> graph_lock(m_graph_access);
           mCRL2log(log::debug) << "generated equation " << X_e << " = " << psi_e
                                << " with rank " << k << std::endl;
-          on_report_equation(thread_index, m_graph_access, X_e, psi_e, k);
+          on_report_equation(thread_index, X_e, psi_e, k);
           todo.insert(occ.begin(), occ.end(), discovered, thread_index);
           for (auto i = occ.begin(); i != occ.end(); ++i)
           {
@@ -430,35 +467,95 @@ class pbesinst_lazy_algorithm
           on_discovered_elements(occ);
 
           if (solution_found(init))
+          {
+            m_must_abort = true;
+          }
+        }
+        m_busy_threads--;
+        m_todo_changed.notify_all();
+      }
+      todo_lock.unlock();
+      m_todo_changed.notify_all();
+
+      if (m_options.number_of_threads>1) mCRL2log(log::debug) << "Stop thread " << thread_index << ".\n";
+    }
+
+    // Processes the elements of the queue of this thread in todo, and steals elements from the
+    // queues of other threads if its own queue is empty. Newly discovered elements are claimed
+    // by inserting them in discovered, which is thread safe, such that the queues contain every
+    // element at most once. Only the reporting of the equation requires exclusive access to the graph.
+    void run_work_stealing_thread(const std::size_t thread_index,
+                                  pbesinst_lazy_work_stealing_todo& todo,
+                                  data::mutable_indexed_substitution<> sigma,
+                                  enumerate_quantifiers_rewriter R
+                                 )
+    {
+      mCRL2log(log::debug) << "Start thread " << thread_index << ".\n";
+      R.thread_initialise();
+
+      propositional_variable_instantiation X_e;
+      pbes_expression psi_e;
+      atermpp::vector<propositional_variable_instantiation> new_elements;
+      std::size_t equation_count = 0;
+
+      while (!m_must_abort)
+      {
+        if (!todo.choose_element(thread_index, X_e))
+        {
+          if (todo.empty())
           {
             break;
           }
+          std::this_thread::yield();
+          continue;
         }
-        m_todo_access.unlock();
-
-        // Check whether all processes are ready. If so the
-        // number_of_active_processes becomes 0. Otherwise, this thread becomes
-        // active again, and tries to see whether the todo buffer is not empty,
-        // to take up more work.
-        number_of_active_processes--;
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        if (number_of_active_processes > 0)
+
+        instantiate_equation(thread_index, X_e, psi_e, sigma, R);
+        std::set<propositional_variable_instantiation> occ = find_propositional_variable_instantiations(psi_e);
+        for (const propositional_variable_instantiation& Y: occ)
         {
-          number_of_active_processes++;
+          if (discovered.insert(Y, thread_index).second)
+          {
+            new_elements.push_back(Y);
+          }
+        }
+
+        // report the generated equation
+        std::size_t k = m_equation_index.rank(X_e.name());
+        {
+          std::unique_lock<std::shared_mutex> graph_lock(m_graph_access);
+          ++m_iteration_count;
+          mCRL2log(log::status) << status_message(m_iteration_count);
+          detail::check_bes_equation_limit(m_iteration_count);
+
+          mCRL2log(log::debug) << "generated equation " << X_e << " = " << psi_e
+                               << " with rank " << k << std::endl;
+          on_report_equation(thread_index, X_e, psi_e, k);
+          on_discovered_elements(occ);
+
+          if (solution_found(init))
+          {
+            m_must_abort = true;
+          }
         }
+
+        todo.insert(thread_index, new_elements.begin(), new_elements.end());
+        new_elements.clear();
+        todo.finish_state();
+        equation_count++;
       }
 
-      if (m_options.number_of_threads>1) mCRL2log(log::debug) << "Stop thread " << thread_index << ".\n";
+      mCRL2log(log::debug) << "Stop thread " << thread_index << " after generating " << equation_count << " BES equations.\n";
     }
 
     /// \brief Runs the algorithm. The result is obtained by calling the function \p get_result.
     virtual void run()
     {
       m_iteration_count = 0;
+      m_must_abort = false;
 
       const std::size_t number_of_threads = m_options.number_of_threads;
       const std::size_t initialisation_thread_index = (number_of_threads==1?0:1);
-      std::atomic<std::size_t> number_of_active_processes = number_of_threads;
       std::vector<std::thread> threads;
 
       data::mutable_indexed_substitution<> sigma;
@@ -468,18 +565,42 @@ class pbesinst_lazy_algorithm
       }
 
       init = atermpp::down_cast<propositional_variable_instantiation>(m_global_R(m_pbes.initial_state(), sigma));
-      todo.insert(init);
       discovered.insert(init, initialisation_thread_index);
 
-      if (number_of_threads>1)
+      if (number_of_threads>1 && !requires_shared_todo())
+      {
+        // Every thread has its own queue, from which it takes elements breadth or depth first.
+        pbesinst_lazy_work_stealing_todo todo_queues(number_of_threads, m_options.exploration_strategy != breadth_first);
+        todo_queues.insert(initialisation_thread_index, init);
+
+        threads.reserve(number_of_threads);
+        for (std::size_t i = 1; i <= number_of_threads; ++i)
+        {
+          std::thread tr([&, i](){
+            run_work_stealing_thread(i,
+                                     todo_queues,
+                                     sigma.clone(),
+                                     m_global_R.clone()
+                                    );
+          });
+          threads.push_back(std::move(tr));
+        }
+
+        for (std::size_t i = 1; i <= number_of_threads; ++i)
+        {
+          threads[i-1].join();
+        }
+        mCRL2log(log::debug) << "Number of times that elements were stolen by a thread: " << todo_queues.steal_count() << ".\n";
+      }
+      else if (number_of_threads>1)
       {
+        todo.insert(init);
         threads.reserve(number_of_threads);
         for (std::size_t i = 1; i <= number_of_threads; ++i)
         {
           std::thread tr([&, i](){
             run_thread(i,
                        todo,
-                       number_of_active_processes,
                        sigma.clone(),
                        m_global_R.clone()
                       );
@@ -495,10 +616,10 @@ class pbesinst_lazy_algorithm
       else 
       {
         // There is only one thread. Run the process in the main thread, without cloning sigma or the rewriter.
+        todo.insert(init);
         const std::size_t single_thread_index=0;
         run_thread(single_thread_index,
                    todo,
-                   number_of_active_processes,
                    sigma,
                    m_global_R
                   );
@@ -12,8 +12,6 @@
 #ifndef MCRL2_PBES_PBESINST_STRUCTURE_GRAPH2_H
 #define MCRL2_PBES_PBESINST_STRUCTURE_GRAPH2_H
 
-#include <shared_mutex>
-
 #include "mcrl2/atermpp/standard_containers/deque.h"
 #include "mcrl2/atermpp/standard_containers/indexed_set.h"
 #include "mcrl2/atermpp/standard_containers/vector.h"
@@ -79,7 +77,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
     std::array<strategy_vector, 2> tau;
     std::array<detail::computation_guard, 2> S_guard;
 
-    atermpp::vector<pbes_expression> b; // to store the result of the Rplus computation
+    atermpp::vector<pbes_expression> b; // to store the result of the Rplus computation, per thread index
     detail::computation_guard find_loops_guard;
     detail::computation_guard fatal_attractors_guard;
     detail::periodic_guard reset_guard;
@@ -499,9 +497,15 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
       structure_graph& G
     )
       : pbesinst_structure_graph_algorithm(options, p, G),
-        b(options.number_of_threads), find_loops_guard(2), fatal_attractors_guard(2)
+        b(options.number_of_threads + 1), find_loops_guard(2), fatal_attractors_guard(2)
     {}
 
+    // Pruning the todo list, and the partial solving of optimizations 7 and 8 inspect the todo list.
+    bool requires_shared_todo() const override
+    {
+      return m_options.prune_todo_list || m_options.optimization >= 7;
+    }
+
     // Optimization 2 is implemented by overriding the function rewrite_psi.
     void rewrite_psi(const std::size_t thread_index,
                      pbes_expression& result,
@@ -527,12 +531,11 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
     }
 
     void on_report_equation(const std::size_t thread_index,
-                            std::shared_mutex& realloc_mutex,
                             const propositional_variable_instantiation& X,
                             const pbes_expression& psi, std::size_t k
                            ) override
     {
-      super::on_report_equation(thread_index, realloc_mutex, X, psi, k);
+      super::on_report_equation(thread_index, X, psi, k);
 
       // The structure graph has just been extended, so S[0] and S[1] need to be resized.
       S[0].resize(m_graph_builder.extent());
@@ -26,6 +26,7 @@
 #include "mcrl2/pbes/unify_parameters.h"
 #include "mcrl2/symbolic/symbolic_reachability.h"
 #include "mcrl2/symbolic/print.h"
+#include "mcrl2/symbolic/saturation.h"
 #include "mcrl2/utilities/stopwatch.h"
 #include "mcrl2/utilities/text_utility.h"
 
@@ -209,6 +210,7 @@ class pbesreach_algorithm
     ldd m_todo;
     ldd m_deadlocks;
     ldd m_initial_vertex;
+    std::unique_ptr<symbolic::saturation_algorithm> m_saturation; // only used if the saturation option is set
 
     /// \brief Updates R.L := R.L U {(x,y) in R | x in X}
     void learn_successors(std::size_t i, pbes_summand_group& R, const ldd& X)
@@ -395,47 +397,32 @@ class pbesreach_algorithm
       }
       else
       {
-        // saturation and chaining
-        todo1 = todo;
-        ldd todo1_old; // the old todo set.
-
-        for (std::size_t i = 0; i < R.size(); i++)
+        // saturation
+        if (learn_transitions)
         {
-          if (learn_transitions)
+          for (std::size_t i = 0; i < R.size(); i++)
           {
-            ldd proj = project(todo1, R[i].Ip);
+            ldd proj = project(todo, R[i].Ip);
             learn_successors(i, R[i], m_options.cached ? minus(proj, R[i].Ldomain) : proj);
 
             mCRL2log(log::debug1) << "L =\n" << print_relation(m_data_index, R[i].L, R[i].read, R[i].write) << std::endl;
           }
+        }
 
-          // Apply one transition relation repeatedly.
-          do
-          {
-            todo1_old = todo1;
-            todo1 = union_(todo1, relprod_impl(todo1, R[i], i));
-          }
-          while (todo1 != todo1_old);
-
-          if (detect_deadlocks)
-          {
-            potential_deadlocks = minus(potential_deadlocks, relprev(todo1, R[i].L, R[i].Ir, potential_deadlocks));
-          }
+        if (!m_saturation)
+        {
+          m_saturation = std::make_unique<symbolic::saturation_algorithm>(R);
+        }
+        ldd saturated = m_saturation->run(todo);
 
-          // Apply all previously learned transition relations repeatedly.
-          if (m_options.chaining)
+        if (detect_deadlocks)
+        {
+          for (std::size_t i = 0; i < R.size(); i++)
           {
-            do
-            {
-              todo1_old = todo1;
-              for (std::size_t j = 0; j <= i; j++)
-              {
-                todo1 = union_(todo1, relprod_impl(todo1, R[j], j));
-              }
-            }
-            while (todo1 != todo1_old);
+            potential_deadlocks = minus(potential_deadlocks, relprev(saturated, R[i].L, R[i].Ir, potential_deadlocks));
           }
         }
+        todo1 = minus(saturated, todo);
       }
 
       // after all transition groups are applied the remaining potential deadlocks are actual deadlocks.
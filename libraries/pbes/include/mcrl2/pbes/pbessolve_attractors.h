@@ -12,7 +12,11 @@
 #ifndef MCRL2_PBES_PBESSOLVE_ATTRACTORS_H
 #define MCRL2_PBES_PBESSOLVE_ATTRACTORS_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include "mcrl2/pbes/pbessolve_vertex_set.h"
+#include "mcrl2/utilities/detail/parallel_for.h"
 
 namespace mcrl2 {
 
@@ -184,6 +188,91 @@ vertex_set attr_default_with_tau(const StructureGraph& G, vertex_set A, std::siz
   return attr_default_generic(G, A, alpha, global_local_strategy<StructureGraph>(G, tau, alpha));
 }
 
+// Computes an attractor set, by extending A, using the given number of threads.
+// The vertices are added in breadth first layers. If a layer is large enough, the predecessors
+// of its vertices are examined in parallel, and the thread that is the first to claim a vertex
+// adds it to the next layer. The strategy of an added vertex is set to the vertex of the previous
+// layer through which it was found. The result is equal to that of attr_default, but the
+// strategies may be different.
+// alpha = 0: disjunctive
+// alpha = 1: conjunctive
+template <typename StructureGraph>
+vertex_set attr_default_parallel(const StructureGraph& G, vertex_set A, std::size_t alpha, std::size_t number_of_threads)
+{
+  // Layers with fewer vertices are handled by the calling thread.
+  constexpr std::size_t parallel_layer_size = 1024;
+
+  // The vertices that have been claimed, one bit per vertex. It is only allocated once a large layer is encountered.
+  std::unique_ptr<std::atomic<std::uint64_t>[]> claimed;
+  auto claim = [&](structure_graph::index_type u)
+  {
+    std::uint64_t mask = std::uint64_t(1) << (u % 64);
+    return (claimed[u / 64].fetch_or(mask, std::memory_order_relaxed) & mask) == 0;
+  };
+
+  global_strategy<StructureGraph> tau(G);
+  std::vector<structure_graph::index_type> layer(A.vertices().begin(), A.vertices().end());
+  std::vector<structure_graph::index_type> next_layer;
+  std::mutex next_layer_mutex;
+  while (!layer.empty())
+  {
+    if (number_of_threads <= 1 || layer.size() < parallel_layer_size)
+    {
+      for (structure_graph::index_type u: layer)
+      {
+        for (auto v: G.predecessors(u))
+        {
+          if (!A.contains(v) && (G.decoration(v) == alpha || includes_successors(G, v, A)))
+          {
+            tau.set_strategy(v, u);
+            A.insert(v);
+            next_layer.push_back(v);
+          }
+        }
+      }
+    }
+    else
+    {
+      if (!claimed)
+      {
+        std::size_t n = (A.extent() + 63) / 64;
+        claimed = std::make_unique<std::atomic<std::uint64_t>[]>(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+          claimed[i] = 0;
+        }
+      }
+      utilities::detail::parallel_for(number_of_threads, layer.size(), [&](std::size_t begin, std::size_t end)
+        {
+          std::vector<structure_graph::index_type> found;
+          for (std::size_t i = begin; i < end; i++)
+          {
+            structure_graph::index_type u = layer[i];
+            for (auto v: G.predecessors(u))
+            {
+              // A is not modified during a parallel layer, so it can be read without synchronization
+              if (!A.contains(v) && (G.decoration(v) == alpha || includes_successors(G, v, A)) && claim(v))
+              {
+                global_strategy<StructureGraph>(G).set_strategy(v, u);
+                found.push_back(v);
+              }
+            }
+          }
+          std::lock_guard<std::mutex> guard(next_layer_mutex);
+          next_layer.insert(next_layer.end(), found.begin(), found.end());
+        });
+      for (structure_graph::index_type v: next_layer)
+      {
+        A.insert(v);
+      }
+    }
+    std::swap(layer, next_layer);
+    next_layer.clear();
+  }
+
+  return A;
+}
+
 } // namespace pbes_system
 
 } // namespace mcrl2
@@ -12,6 +12,10 @@
 #ifndef MCRL2_PBES_SOLVE_STRUCTURE_GRAPH_H
 #define MCRL2_PBES_SOLVE_STRUCTURE_GRAPH_H
 
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/data/join.h"
 #include "mcrl2/lts/lts_algorithm.h"
@@ -22,36 +26,75 @@ namespace mcrl2 {
 
 namespace pbes_system {
 
-inline
-std::tuple<std::size_t, std::size_t, vertex_set> get_minmax_rank(const structure_graph& G)
+template <typename StructureGraph>
+std::tuple<std::size_t, std::size_t, vertex_set> get_minmax_rank(const StructureGraph& G, std::size_t number_of_threads = 1)
 {
-  std::size_t min_rank = (std::numeric_limits<std::size_t>::max)();
-  std::size_t max_rank = 0;
-  std::vector<structure_graph::index_type> M; // vertices with minimal rank
+  // The minimal and maximal rank of a range of vertices, and the vertices in the range with minimal rank.
+  struct minmax_rank
+  {
+    std::size_t begin;
+    std::size_t min_rank = (std::numeric_limits<std::size_t>::max)();
+    std::size_t max_rank = 0;
+    std::vector<structure_graph::index_type> M;
+
+    explicit minmax_rank(std::size_t begin_)
+      : begin(begin_)
+    {}
+  };
+
   std::size_t N = G.all_vertices().size();
+  std::vector<minmax_rank> ranges;
+  std::mutex ranges_mutex;
 
-  for (std::size_t vi = 0; vi < N; vi++)
-  {
-    if (!G.contains(vi))
+  utilities::detail::parallel_for(number_of_threads, N, [&](std::size_t begin, std::size_t end)
     {
-      continue;
-    }
-    const auto& v = G.find_vertex(vi);
-    if (v.rank <= min_rank)
-    {
-      if (v.rank < min_rank)
+      minmax_rank r(begin);
+      for (std::size_t vi = begin; vi < end; vi++)
       {
-        M.clear();
-        min_rank = v.rank;
+        if (!G.contains(vi))
+        {
+          continue;
+        }
+        const auto& v = G.find_vertex(vi);
+        if (v.rank <= r.min_rank)
+        {
+          if (v.rank < r.min_rank)
+          {
+            r.M.clear();
+            r.min_rank = v.rank;
+          }
+          r.M.push_back(vi);
+        }
+        if (v.rank > r.max_rank)
+        {
+          r.max_rank = v.rank;
+        }
       }
-      M.push_back(vi);
-    }
-    if (v.rank > max_rank)
+      std::lock_guard<std::mutex> guard(ranges_mutex);
+      ranges.push_back(std::move(r));
+    });
+
+  // Combine the ranges in increasing order, such that M is sorted
+  std::sort(ranges.begin(), ranges.end(), [](const minmax_rank& x, const minmax_rank& y) { return x.begin < y.begin; });
+  std::size_t min_rank = (std::numeric_limits<std::size_t>::max)();
+  std::size_t max_rank = 0;
+  for (const minmax_rank& r: ranges)
+  {
+    min_rank = std::min(min_rank, r.min_rank);
+    max_rank = std::max(max_rank, r.max_rank);
+  }
+  vertex_set M(N);
+  for (const minmax_rank& r: ranges)
+  {
+    if (r.min_rank == min_rank)
     {
-      max_rank = v.rank;
+      for (structure_graph::index_type u: r.M)
+      {
+        M.insert(u);
+      }
     }
   }
-  return std::make_tuple(min_rank, max_rank, vertex_set(N, M.begin(), M.end()));
+  return std::make_tuple(min_rank, max_rank, M);
 }
 
 /// \brief Guesses if a pbes has counter example information
@@ -79,8 +122,18 @@ class solve_structure_graph_algorithm
 
     bool use_toms_optimization = false;
 
+    // The number of threads that is used for solving
+    std::size_t m_number_of_threads = 1;
+
+    // The number of threads that is still available for solving subgames in parallel
+    std::atomic<std::size_t> m_free_threads{0};
+
+    // Subgames with fewer vertices are not split into independent subgames
+    static constexpr std::size_t parallel_subgame_size = 1 << 14;
+
     // find a successor of u
-    static structure_graph::index_type succ(const structure_graph& G, structure_graph::index_type u)
+    template <typename StructureGraph>
+    static structure_graph::index_type succ(const StructureGraph& G, structure_graph::index_type u)
     {
       for (structure_graph::index_type v: G.successors(u))
       {
@@ -90,8 +143,8 @@ class solve_structure_graph_algorithm
     }
 
     // find a successor of u in U, or a random one if no successor in U exists
-    static inline
-    structure_graph::index_type succ(const structure_graph& G, structure_graph::index_type u, const vertex_set& U)
+    template <typename StructureGraph>
+    static structure_graph::index_type succ(const StructureGraph& G, structure_graph::index_type u, const vertex_set& U)
     {
       auto result = undefined_vertex();
       for (structure_graph::index_type v: G.successors(u))
@@ -105,10 +158,182 @@ class solve_structure_graph_algorithm
       return result;
     }
 
+    // Returns the number of threads that can be used for the computations on a single (sub)game.
+    // While independent subgames are solved in parallel, each of them is handled by one thread.
+    std::size_t available_threads() const
+    {
+      return m_free_threads + 1 == m_number_of_threads ? m_number_of_threads : 1;
+    }
+
+    template <typename StructureGraph>
+    vertex_set attr(const StructureGraph& G, const vertex_set& A, std::size_t alpha) const
+    {
+      std::size_t number_of_threads = available_threads();
+      if (number_of_threads > 1)
+      {
+        return attr_default_parallel(G, A, alpha, number_of_threads);
+      }
+      return attr_default(G, A, alpha);
+    }
+
+    // Tries to reserve at most n of the free threads, and returns the number of reserved threads.
+    std::size_t reserve_threads(std::size_t n)
+    {
+      std::size_t free = m_free_threads;
+      std::size_t k;
+      do
+      {
+        k = std::min(n, free);
+      }
+      while (k > 0 && !m_free_threads.compare_exchange_weak(free, free - k));
+      return k;
+    }
+
+    // Adds the vertices of the weakly connected component of G that contains u to component.
+    // Returns the number of vertices of the component.
+    template <typename StructureGraph>
+    static std::size_t visit_component(const StructureGraph& G, structure_graph::index_type u, boost::dynamic_bitset<>& visited, boost::dynamic_bitset<>& component)
+    {
+      std::size_t count = 0;
+      std::vector<structure_graph::index_type> todo = { u };
+      visited[u] = true;
+      while (!todo.empty())
+      {
+        structure_graph::index_type v = todo.back();
+        todo.pop_back();
+        component[v] = true;
+        count++;
+        auto visit = [&](structure_graph::index_type w)
+        {
+          if (!visited[w])
+          {
+            visited[w] = true;
+            todo.push_back(w);
+          }
+        };
+        for (structure_graph::index_type w: G.successors(v))
+        {
+          visit(w);
+        }
+        for (structure_graph::index_type w: G.predecessors(v))
+        {
+          visit(w);
+        }
+      }
+      return count;
+    }
+
+    // If G consists of several weakly connected components, they are independent subgames. In that case
+    // the components are distributed over a number of groups, that are solved in parallel, and true
+    // is returned. Otherwise false is returned.
+    template <typename StructureGraph>
+    bool solve_components_in_parallel(const StructureGraph& G, std::pair<vertex_set, vertex_set>& result)
+    {
+      std::size_t N = G.extent();
+      std::size_t size = N - G.exclude().count();
+      if (size < parallel_subgame_size || m_free_threads == 0)
+      {
+        return false;
+      }
+
+      // Excluded vertices are considered to be visited
+      boost::dynamic_bitset<> visited = G.exclude();
+      std::size_t first = visited.size();
+      for (std::size_t u = 0; u < N; u++)
+      {
+        if (!visited[u])
+        {
+          first = u;
+          break;
+        }
+      }
+      boost::dynamic_bitset<> first_component(N);
+      std::size_t first_size = visit_component(G, first, visited, first_component);
+      if (first_size == size)
+      {
+        return false;
+      }
+
+      std::size_t k = 1 + reserve_threads(m_number_of_threads - 1);
+      if (k == 1)
+      {
+        return false;
+      }
+
+      // Assign the components to k groups, by adding each component to the smallest group
+      std::vector<boost::dynamic_bitset<>> groups(k, boost::dynamic_bitset<>(N));
+      std::vector<std::size_t> group_sizes(k, 0);
+      groups[0] = std::move(first_component);
+      group_sizes[0] = first_size;
+      for (std::size_t u = first; u < N; u++)
+      {
+        if (!visited[u])
+        {
+          std::size_t g = std::min_element(group_sizes.begin(), group_sizes.end()) - group_sizes.begin();
+          group_sizes[g] += visit_component(G, u, visited, groups[g]);
+        }
+      }
+
+      // Release the threads of empty groups
+      while (group_sizes.back() == 0)
+      {
+        groups.pop_back();
+        group_sizes.pop_back();
+        m_free_threads++;
+      }
+      k = groups.size();
+      mCRL2log(log::debug) << "solving " << k << " independent subgames of " << size << " vertices in parallel" << std::endl;
+
+      std::vector<std::pair<vertex_set, vertex_set>> W(k);
+      std::vector<std::exception_ptr> exceptions(k);
+      auto solve_group = [&](std::size_t g)
+      {
+        try
+        {
+          structure_subgraph H(G, ~groups[g]);
+          W[g] = solve_recursive(H);
+        }
+        catch (...)
+        {
+          exceptions[g] = std::current_exception();
+        }
+      };
+
+      std::vector<std::thread> threads;
+      for (std::size_t g = 1; g < k; g++)
+      {
+        threads.emplace_back([&, g]()
+          {
+            solve_group(g);
+            m_free_threads++;
+          });
+      }
+      solve_group(0);
+      for (std::thread& t: threads)
+      {
+        t.join();
+      }
+      for (const std::exception_ptr& e: exceptions)
+      {
+        if (e)
+        {
+          std::rethrow_exception(e);
+        }
+      }
+
+      result = W[0];
+      for (std::size_t g = 1; g < k; g++)
+      {
+        result.first = set_union(result.first, W[g].first);
+        result.second = set_union(result.second, W[g].second);
+      }
+      return true;
+    }
+
   public:
     // computes solve_recursive(G \ A)
-    inline
-    std::pair<vertex_set, vertex_set> solve_recursive(structure_graph& G, const vertex_set& A)
+    template <typename StructureGraph>
+    std::pair<vertex_set, vertex_set> solve_recursive(StructureGraph& G, const vertex_set& A)
     {
       auto exclude = G.exclude() | A.include();
       std::swap(G.exclude(), exclude);
@@ -122,8 +347,8 @@ class solve_structure_graph_algorithm
     //
     // N.B. If use_toms_optimization is true, then the oomputed strategy may be incorrect.
     // So this flag should only be used to compute the solution.
-    inline
-    std::pair<vertex_set, vertex_set> solve_recursive(structure_graph& G)
+    template <typename StructureGraph>
+    std::pair<vertex_set, vertex_set> solve_recursive(StructureGraph& G)
     {
       mCRL2log(log::debug) << "\n  --- solve_recursive input ---\n" << G << std::endl;
       std::size_t N = G.extent();
@@ -133,7 +358,16 @@ class solve_structure_graph_algorithm
         return { vertex_set(N), vertex_set(N) };
       }
 
-      auto q = get_minmax_rank(G);
+      if (m_number_of_threads > 1)
+      {
+        std::pair<vertex_set, vertex_set> W;
+        if (solve_components_in_parallel(G, W))
+        {
+          return W;
+        }
+      }
+
+      auto q = get_minmax_rank(G, available_threads());
       std::size_t m = std::get<0>(q);
       const vertex_set& U = std::get<2>(q);
 
@@ -149,7 +383,7 @@ class solve_structure_graph_algorithm
           auto v = succ(G, ui, U);
           if (v != undefined_vertex())
           {
-            global_strategy<structure_graph>(G).set_strategy(ui, v);
+            global_strategy<StructureGraph>(G).set_strategy(ui, v);
 //            mCRL2log(log::debug) << "set initial strategy for node " << ui << " to " << v << std::endl;
           }
         }
@@ -172,14 +406,14 @@ class solve_structure_graph_algorithm
       vertex_set W[2]   = { vertex_set(N), vertex_set(N) };
       vertex_set W_1[2];
 
-      vertex_set A = attr_default(G, U, alpha);
+      vertex_set A = attr(G, U, alpha);
       std::tie(W_1[0], W_1[1]) = solve_recursive(G, A);
 
       if (use_toms_optimization)
       {
         // More efficient than Zielonka, because some recursive calls are skipped.
         // As a consequence, the computed strategy may be wrong.
-        vertex_set B = attr_default(G, W_1[1 - alpha], 1 - alpha);
+        vertex_set B = attr(G, W_1[1 - alpha], 1 - alpha);
         if (W_1[1 - alpha].size() == B.size())
         {
           W[alpha] = set_union(A, W_1[alpha]);
@@ -201,7 +435,7 @@ class solve_structure_graph_algorithm
          }
          else
          {
-           vertex_set B = attr_default(G, W_1[1 - alpha], 1 - alpha);
+           vertex_set B = attr(G, W_1[1 - alpha], 1 - alpha);
            std::tie(W[0], W[1]) = solve_recursive(G, B);
            W[1 - alpha] = set_union(W[1 - alpha], B);
          }
@@ -245,11 +479,11 @@ class solve_structure_graph_algorithm
       // extend Vconj and Vdisj
       if (!Vconj.is_empty())
       {
-        Vconj = attr_default(G, Vconj, 1);
+        Vconj = attr(G, Vconj, 1);
       }
       if (!Vdisj.is_empty())
       {
-        Vdisj = attr_default(G, Vdisj, 0);
+        Vdisj = attr(G, Vdisj, 0);
       }
 
       // default case
@@ -357,9 +591,13 @@ class solve_structure_graph_algorithm
     }
 
   public:
-    explicit solve_structure_graph_algorithm(bool check_strategy_ = false, bool use_toms_optimization_ = false)
+    /// \brief Constructor.
+    /// \param number_of_threads The number of threads that is used for computing attractors and for solving independent subgames.
+    explicit solve_structure_graph_algorithm(bool check_strategy_ = false, bool use_toms_optimization_ = false, std::size_t number_of_threads = 1)
       : check_strategy(check_strategy_),
-        use_toms_optimization(use_toms_optimization_)
+        use_toms_optimization(use_toms_optimization_),
+        m_number_of_threads(std::max(number_of_threads, std::size_t(1))),
+        m_free_threads(m_number_of_threads - 1)
     {}
 
     inline
@@ -461,7 +699,9 @@ class lps_solve_structure_graph_algorithm: public solve_structure_graph_algorith
     }
 
   public:
-    lps_solve_structure_graph_algorithm() = default;
+    explicit lps_solve_structure_graph_algorithm(std::size_t number_of_threads = 1)
+      : solve_structure_graph_algorithm(false, false, number_of_threads)
+    {}
 
     /// \brief Solve a pbes for some equation, while constructing a counter example or wittness based on the accompanying linear process.
     /// \param G       A structure graph.
@@ -543,7 +783,9 @@ class lts_solve_structure_graph_algorithm: public solve_structure_graph_algorith
     }
 
   public:
-    lts_solve_structure_graph_algorithm() = default;
+    explicit lts_solve_structure_graph_algorithm(std::size_t number_of_threads = 1)
+      : solve_structure_graph_algorithm(false, false, number_of_threads)
+    {}
 
     /// \brief Solve a boolean equation system while generating a counter example.
     /// \param G       A structure graph.
@@ -565,27 +807,28 @@ class lts_solve_structure_graph_algorithm: public solve_structure_graph_algorith
 };
 
 inline
-bool solve_structure_graph(structure_graph& G, bool check_strategy = false)
+bool solve_structure_graph(structure_graph& G, bool check_strategy = false, std::size_t number_of_threads = 1)
 {
   bool use_toms_optimization = !check_strategy;
-  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization);
+  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization, number_of_threads);
   return algorithm.solve(G);
 }
 
 inline
-std::pair<bool, lps::specification> solve_structure_graph_with_counter_example(structure_graph& G, const lps::specification& lpsspec, const pbes& p, const pbes_equation_index& p_index)
+std::pair<bool, lps::specification> solve_structure_graph_with_counter_example(structure_graph& G, const lps::specification& lpsspec, const pbes& p, const pbes_equation_index& p_index, std::size_t number_of_threads = 1)
 {
-  lps_solve_structure_graph_algorithm algorithm;
+  lps_solve_structure_graph_algorithm algorithm(number_of_threads);
   return algorithm.solve_with_counter_example(G, lpsspec, p, p_index);
 }
 
 /// \brief Solve this pbes_system using a structure graph generating a counter example.
 /// \param G       The structure graph.
 /// \param ltsspec The original LTS that was used to create the PBES.
+/// \param number_of_threads The number of threads that is used for solving.
 inline
-bool solve_structure_graph_with_counter_example(structure_graph& G, lts::lts_lts_t& ltsspec)
+bool solve_structure_graph_with_counter_example(structure_graph& G, lts::lts_lts_t& ltsspec, std::size_t number_of_threads = 1)
 {
-  lts_solve_structure_graph_algorithm algorithm;
+  lts_solve_structure_graph_algorithm algorithm(number_of_threads);
   return algorithm.solve_with_counter_example(G, ltsspec);
 }
 
@@ -15,6 +15,7 @@
 #include <iomanip>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/core/detail/print_utility.h"
@@ -59,10 +60,13 @@ unsigned int undefined_vertex()
 
 // A structure graph with a facility to exclude a subset of the vertices.
 // It has the same interface as simple_structure_graph.
+// After construction the graph can be frozen, in which case the predecessors and
+// successors of all vertices are stored in a compressed sparse row format.
 class structure_graph
 {
   friend struct detail::structure_graph_builder;
   friend struct detail::manual_structure_graph_builder;
+  friend class structure_subgraph;
 
   public:
     enum decoration_type
@@ -75,6 +79,7 @@ class structure_graph
     };
 
     using index_type = unsigned int;
+    using edge_range = boost::iterator_range<const index_type*>;
 
     // TODO: when using the CMake build, this declaration causes strange linker errors
     // static constexpr index_type undefined_vertex = (std::numeric_limits<index_type>::max)();
@@ -136,6 +141,46 @@ class structure_graph
     index_type m_initial_vertex = 0;
     boost::dynamic_bitset<> m_exclude;
 
+    // The compressed sparse row representation of the edges, which is only used if m_frozen is true.
+    // The predecessors of vertex u are stored in m_predecessors[m_predecessor_offsets[u] ... m_predecessor_offsets[u+1]),
+    // and similarly for the successors.
+    bool m_frozen = false;
+    std::vector<std::size_t> m_predecessor_offsets;
+    std::vector<std::size_t> m_successor_offsets;
+    std::vector<index_type> m_predecessors;
+    std::vector<index_type> m_successors;
+
+    static edge_range make_edge_range(const std::vector<index_type>& v)
+    {
+      return edge_range(v.data(), v.data() + v.size());
+    }
+
+    static edge_range make_edge_range(const std::vector<index_type>& edges, const std::vector<std::size_t>& offsets, index_type u)
+    {
+      return edge_range(edges.data() + offsets[u], edges.data() + offsets[u + 1]);
+    }
+
+    // Moves the edge lists selected by get_edges into one contiguous array.
+    template <typename GetEdges>
+    void compress_edges(std::vector<index_type>& edges, std::vector<std::size_t>& offsets, GetEdges get_edges)
+    {
+      std::size_t N = m_vertices.size();
+      offsets.resize(N + 1);
+      offsets[0] = 0;
+      for (std::size_t u = 0; u < N; u++)
+      {
+        offsets[u + 1] = offsets[u] + get_edges(m_vertices[u]).size();
+      }
+      edges.clear();
+      edges.reserve(offsets[N]);
+      for (vertex& u: m_vertices)
+      {
+        std::vector<index_type>& E = get_edges(u);
+        edges.insert(edges.end(), E.begin(), E.end());
+        std::vector<index_type>().swap(E);
+      }
+    }
+
     struct integers_not_contained_in
     {
       const boost::dynamic_bitset<>& subset;
@@ -201,14 +246,22 @@ class structure_graph
       return m_vertices;
     }
 
-    const std::vector<index_type>& all_predecessors(index_type u) const
+    edge_range all_predecessors(index_type u) const
     {
-      return find_vertex(u).predecessors;
+      if (m_frozen)
+      {
+        return make_edge_range(m_predecessors, m_predecessor_offsets, u);
+      }
+      return make_edge_range(find_vertex(u).predecessors);
     }
 
-    const std::vector<index_type>& all_successors(index_type u) const
+    edge_range all_successors(index_type u) const
     {
-      return find_vertex(u).successors;
+      if (m_frozen)
+      {
+        return make_edge_range(m_successors, m_successor_offsets, u);
+      }
+      return make_edge_range(find_vertex(u).successors);
     }
 
     boost::filtered_range<vertices_not_contained_in, const atermpp::vector<vertex>> vertices() const
@@ -216,12 +269,12 @@ class structure_graph
       return all_vertices() | boost::adaptors::filtered(vertices_not_contained_in(m_vertices, m_exclude));
     }
 
-    boost::filtered_range<integers_not_contained_in, const std::vector<index_type>> predecessors(index_type u) const
+    boost::filtered_range<integers_not_contained_in, const edge_range> predecessors(index_type u) const
     {
       return all_predecessors(u) | boost::adaptors::filtered(integers_not_contained_in(m_exclude));
     }
 
-    boost::filtered_range<integers_not_contained_in, const std::vector<index_type>> successors(index_type u) const
+    boost::filtered_range<integers_not_contained_in, const edge_range> successors(index_type u) const
     {
       return all_successors(u) | boost::adaptors::filtered(integers_not_contained_in(m_exclude));
     }
@@ -267,7 +320,147 @@ class structure_graph
     // Returns true if all vertices have a rank and a decoration
     bool is_defined() const
     {
-      return std::all_of(m_vertices.begin(), m_vertices.end(), [](const vertex& u) { return u.is_defined(); });
+      if (!m_frozen)
+      {
+        return std::all_of(m_vertices.begin(), m_vertices.end(), [](const vertex& u) { return u.is_defined(); });
+      }
+      for (std::size_t i = 0; i < m_vertices.size(); i++)
+      {
+        const vertex& u = m_vertices[i];
+        if ((u.decoration == d_none && u.rank == data::undefined_index())
+            || (all_successors(i).empty() && u.decoration != d_true && u.decoration != d_false))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // Returns true if the edges are stored in the compressed sparse row format.
+    bool is_frozen() const
+    {
+      return m_frozen;
+    }
+
+    // Moves the predecessors and successors of all vertices into two contiguous arrays, and
+    // releases the edge lists of the vertices. This saves a heap allocation per edge list and
+    // improves the locality of the solving algorithms. The edges of a frozen graph can no
+    // longer be modified.
+    void freeze()
+    {
+      if (m_frozen)
+      {
+        return;
+      }
+      compress_edges(m_predecessors, m_predecessor_offsets, [](vertex& u) -> std::vector<index_type>& { return u.predecessors; });
+      compress_edges(m_successors, m_successor_offsets, [](vertex& u) -> std::vector<index_type>& { return u.successors; });
+      m_frozen = true;
+    }
+};
+
+// A view on a structure graph that excludes a subset of its vertices, independently of the
+// subset that is excluded by the structure graph itself. It has the same interface as
+// structure_graph, except that the vertices cannot be modified. It is used to solve
+// subgames of a structure graph in parallel, where every thread has its own exclude set.
+class structure_subgraph
+{
+  public:
+    using index_type = structure_graph::index_type;
+    using vertex = structure_graph::vertex;
+    using decoration_type = structure_graph::decoration_type;
+    using edge_range = structure_graph::edge_range;
+
+  protected:
+    const structure_graph& m_graph;
+    boost::dynamic_bitset<> m_exclude;
+
+  public:
+    structure_subgraph(const structure_graph& G, boost::dynamic_bitset<> exclude)
+      : m_graph(G),
+        m_exclude(std::move(exclude))
+    {
+      assert(m_exclude.size() == m_graph.extent());
+    }
+
+    // A subgraph of a subgraph is a subgraph of the original structure graph.
+    structure_subgraph(const structure_subgraph& G, boost::dynamic_bitset<> exclude)
+      : structure_subgraph(G.m_graph, std::move(exclude))
+    {}
+
+    index_type initial_vertex() const
+    {
+      return m_graph.initial_vertex();
+    }
+
+    std::size_t extent() const
+    {
+      return m_graph.extent();
+    }
+
+    decoration_type decoration(index_type u) const
+    {
+      return m_graph.decoration(u);
+    }
+
+    std::size_t rank(index_type u) const
+    {
+      return m_graph.rank(u);
+    }
+
+    const atermpp::vector<vertex>& all_vertices() const
+    {
+      return m_graph.all_vertices();
+    }
+
+    edge_range all_predecessors(index_type u) const
+    {
+      return m_graph.all_predecessors(u);
+    }
+
+    edge_range all_successors(index_type u) const
+    {
+      return m_graph.all_successors(u);
+    }
+
+    boost::filtered_range<structure_graph::integers_not_contained_in, const edge_range> predecessors(index_type u) const
+    {
+      return all_predecessors(u) | boost::adaptors::filtered(structure_graph::integers_not_contained_in(m_exclude));
+    }
+
+    boost::filtered_range<structure_graph::integers_not_contained_in, const edge_range> successors(index_type u) const
+    {
+      return all_successors(u) | boost::adaptors::filtered(structure_graph::integers_not_contained_in(m_exclude));
+    }
+
+    index_type strategy(index_type u) const
+    {
+      return m_graph.strategy(u);
+    }
+
+    // N.B. The strategy attribute of the returned vertex is mutable.
+    const vertex& find_vertex(index_type u) const
+    {
+      return m_graph.find_vertex(u);
+    }
+
+    const boost::dynamic_bitset<>& exclude() const
+    {
+      return m_exclude;
+    }
+
+    boost::dynamic_bitset<>& exclude()
+    {
+      return m_exclude;
+    }
+
+    bool contains(index_type u) const
+    {
+      return !m_exclude[u];
+    }
+
+    bool is_empty() const
+    {
+      return detail::call_dynamic_bitset_all(m_exclude);
     }
 };
 
@@ -353,6 +546,12 @@ std::ostream& operator<<(std::ostream& out, const structure_graph& G)
   return print_structure_graph(out, G);
 }
 
+inline
+std::ostream& operator<<(std::ostream& out, const structure_subgraph& G)
+{
+  return print_structure_graph(out, G);
+}
+
 } // namespace pbes_system
 
 } // namespace mcrl2
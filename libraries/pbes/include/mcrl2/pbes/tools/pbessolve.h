@@ -254,7 +254,7 @@ class pbessolve_tool
       lps::specification evidence;
       timer().start("solving");
       std::tie(result, evidence) = solve_structure_graph_with_counter_example(
-          G, lpsspec, pbesspec, algorithm.equation_index());
+          G, lpsspec, pbesspec, algorithm.equation_index(), options.number_of_threads);
       timer().finish("solving");
       std::cout << (result ? "true" : "false") << std::endl;
       if (evidence_file.empty())
@@ -272,7 +272,7 @@ class pbessolve_tool
       ltsspec.load(ltsfile);
       lts::lts_lts_t evidence;
       timer().start("solving");
-      bool result = solve_structure_graph_with_counter_example(G, ltsspec);
+      bool result = solve_structure_graph_with_counter_example(G, ltsspec, options.number_of_threads);
       timer().finish("solving");
       std::cout << (result ? "true" : "false") << std::endl;
       if (evidence_file.empty())
@@ -287,7 +287,7 @@ class pbessolve_tool
     else
     {
       timer().start("solving");
-      bool result = solve_structure_graph(G, options.check_strategy);
+      bool result = solve_structure_graph(G, options.check_strategy, options.number_of_threads);
       timer().finish("solving");
       std::cout << (result ? "true" : "false") << std::endl;
     }
@@ -51,7 +51,7 @@ void save_pbes(const pbes& pbes,
   mCRL2log(log::verbose) << "Saving result in " << format.shortname() << " format..." << std::endl;
   if (format == pbes_format_internal())
   {
-    atermpp::binary_aterm_ostream(stream) << pbes;
+    atermpp::chunked_binary_aterm_ostream(stream) << pbes;
   }
   else
   if (format == pbes_format_text())
@@ -307,7 +307,7 @@ void save_pbes(const pbes& pbesspec, const std::string& filename)
 {
   if (filename.empty())
   {
-    atermpp::binary_aterm_ostream(std::cout) << pbesspec;
+    atermpp::chunked_binary_aterm_ostream(std::cout) << pbesspec;
   }
   else
   {
@@ -316,7 +316,7 @@ void save_pbes(const pbes& pbesspec, const std::string& filename)
     {
       throw mcrl2::runtime_error("Could not write to filename " + filename);
     }
-    atermpp::binary_aterm_ostream(to) << pbesspec;
+    atermpp::chunked_binary_aterm_ostream(to) << pbesspec;
   }
 }
 
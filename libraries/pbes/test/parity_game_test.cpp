@@ -14,12 +14,15 @@
 #define BOOST_TEST_MODULE parity_game_test
 #include <boost/test/included/unit_test.hpp>
 
+#include <random>
 #include "mcrl2/lps/detail/test_input.h"
 #include "mcrl2/modal_formula/detail/test_input.h"
 #include "mcrl2/pbes/detail/parity_game_output.h"
 #include "mcrl2/pbes/detail/pbessolve.h"
 #include "mcrl2/pbes/lps2pbes.h"
+#include "mcrl2/pbes/pbesinst_structure_graph2.h"
 #include "mcrl2/pbes/print.h"
+#include "mcrl2/pbes/solve_structure_graph.h"
 #include "mcrl2/pbes/txt2pbes.h"
 
 using namespace mcrl2;
@@ -217,6 +220,179 @@ BOOST_AUTO_TEST_CASE(pbes_test)
   test_pbespgsolve(PBES3);
 }
 
+// Checks that the compressed edges of a frozen structure graph are consistent
+void check_frozen_structure_graph(const pbes_system::structure_graph& G)
+{
+  BOOST_CHECK(G.is_frozen());
+  for (pbes_system::structure_graph::index_type u = 0; u < G.extent(); u++)
+  {
+    BOOST_CHECK(G.find_vertex(u).successors.empty());
+    BOOST_CHECK(G.find_vertex(u).predecessors.empty());
+    for (pbes_system::structure_graph::index_type v: G.all_successors(u))
+    {
+      auto P = G.all_predecessors(v);
+      BOOST_CHECK(std::find(P.begin(), P.end(), u) != P.end());
+    }
+  }
+}
+
+void test_frozen_structure_graph(const std::string& pbes_spec, const bool expected_result)
+{
+  using namespace pbes_system;
+  pbes p = txt2pbes(pbes_spec);
+  algorithms::normalize(p);
+  structure_graph G;
+  pbesinst_structure_graph_algorithm algorithm(pbessolve_options(), p, G);
+  algorithm.run();
+  check_frozen_structure_graph(G);
+  BOOST_CHECK_EQUAL(solve_structure_graph(G, true), expected_result);
+}
+
+BOOST_AUTO_TEST_CASE(frozen_structure_graph_test)
+{
+  std::string PBES1 =
+    "pbes nu X(n: Nat) = (val(n < 5) && X(n + 1)) || Y(n); \n"
+    "     mu Y(n: Nat) = val(n > 2) && Y(n);               \n"
+    "                                                      \n"
+    "init X(0);                                            \n"
+  ;
+  std::string PBES2 =
+    "pbes nu X(b: Bool) = X(!b) && Y(b); \n"
+    "     mu Y(b: Bool) = Y(!b) || X(b); \n"
+    "                                    \n"
+    "init X(true);                       \n"
+  ;
+  test_frozen_structure_graph(PBES1, false);
+  test_frozen_structure_graph(PBES2, true);
+
+  // Solving a manually constructed graph before and after freezing must give the same result.
+  pbes_system::structure_graph G;
+  pbes_system::detail::manual_structure_graph_builder builder(G);
+  auto u0 = builder.insert_vertex(false, 1);
+  auto u1 = builder.insert_vertex(true, 0);
+  auto u2 = builder.insert_vertex(false, 2);
+  builder.insert_edge(u0, u1);
+  builder.insert_edge(u0, u2);
+  builder.insert_edge(u1, u0);
+  builder.insert_edge(u1, u1);
+  builder.insert_edge(u2, u2);
+  builder.set_initial_state(u0);
+  builder.finalize();
+  bool result = pbes_system::solve_structure_graph(G, true);
+  G.freeze();
+  check_frozen_structure_graph(G);
+  BOOST_CHECK_EQUAL(pbes_system::solve_structure_graph(G, true), result);
+}
+
+void test_parallel_instantiation(const std::string& pbes_spec, const bool expected_result)
+{
+  using namespace pbes_system;
+  pbes p = txt2pbes(pbes_spec);
+  algorithms::normalize(p);
+
+  structure_graph G1;
+  pbesinst_structure_graph_algorithm algorithm1(pbessolve_options(), p, G1);
+  algorithm1.run();
+
+  // Optimization 0 uses the work stealing queues, and optimization 7 uses the shared todo list.
+  for (int optimization: { 0, 2, 3, 7 })
+  {
+    for (search_strategy strategy: { breadth_first, depth_first })
+    {
+      pbessolve_options options;
+      options.number_of_threads = 4;
+      options.optimization = optimization;
+      options.exploration_strategy = strategy;
+      structure_graph G;
+      if (optimization <= 1)
+      {
+        pbesinst_structure_graph_algorithm algorithm(options, p, G);
+        algorithm.run();
+        // Without on-the-fly solving all equations are generated.
+        BOOST_CHECK_EQUAL(G.extent(), G1.extent());
+      }
+      else
+      {
+        pbesinst_structure_graph_algorithm2 algorithm(options, p, G);
+        algorithm.run();
+      }
+      BOOST_CHECK_EQUAL(solve_structure_graph(G, true), expected_result);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_instantiation_test)
+{
+  std::string PBES1 =
+    "pbes nu X(n: Nat) = (val(n < 500) && X(n + 1)) || Y(n); \n"
+    "     mu Y(n: Nat) = val(n > 2) && Y(n);                 \n"
+    "                                                        \n"
+    "init X(0);                                              \n"
+  ;
+  std::string PBES2 =
+    "pbes nu X(m, n: Nat) = X((m + 1) mod 20, n) && X(m, (n + 1) mod 20) && Y(m, n); \n"
+    "     mu Y(m, n: Nat) = val(m == 19 && n == 19) || Y((m + 1) mod 20, n) || X(m, n); \n"
+    "                                                                                 \n"
+    "init X(0, 0);                                                                    \n"
+  ;
+  test_parallel_instantiation(PBES1, false);
+  test_parallel_instantiation(PBES2, true);
+}
+
+// Creates a random structure graph that consists of the given number of independent components.
+// Every vertex has an edge to the next vertex in its component, such that the components are connected.
+pbes_system::structure_graph make_random_structure_graph(std::size_t number_of_components, std::size_t component_size)
+{
+  using namespace pbes_system;
+  std::mt19937 generator(12345);
+  structure_graph G;
+  detail::manual_structure_graph_builder builder(G);
+  std::size_t N = number_of_components * component_size;
+  for (std::size_t i = 0; i < N; i++)
+  {
+    builder.insert_vertex(generator() % 2 == 1, generator() % 4);
+  }
+  for (std::size_t i = 0; i < N; i++)
+  {
+    std::size_t first = (i / component_size) * component_size;
+    builder.insert_edge(i, first + (i + 1) % component_size);
+    builder.insert_edge(i, first + generator() % component_size);
+  }
+  builder.set_initial_state(0);
+  builder.finalize();
+  return G;
+}
+
+void test_parallel_solving(std::size_t number_of_components, std::size_t component_size)
+{
+  using namespace pbes_system;
+  structure_graph G = make_random_structure_graph(number_of_components, component_size);
+  vertex_set A(G.extent());
+
+  solve_structure_graph_algorithm algorithm1;
+  auto W1 = algorithm1.solve_recursive(G, A);
+  bool result = solve_structure_graph(G, true);
+  for (std::size_t number_of_threads: { 2, 4 })
+  {
+    solve_structure_graph_algorithm algorithm(false, false, number_of_threads);
+    auto W = algorithm.solve_recursive(G, A);
+    BOOST_CHECK(W.first == W1.first);
+    BOOST_CHECK(W.second == W1.second);
+
+    // The strategies that are computed in parallel must be correct as well
+    BOOST_CHECK_EQUAL(solve_structure_graph(G, true, number_of_threads), result);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_solving_test)
+{
+  // A single component, for which the attractors are computed in parallel
+  test_parallel_solving(1, 50000);
+
+  // Independent components that are solved in parallel
+  test_parallel_solving(8, 4096);
+}
+
 #ifdef MCRL2_EXTENDED_TESTS
 BOOST_AUTO_TEST_CASE(slow_tests)
 {
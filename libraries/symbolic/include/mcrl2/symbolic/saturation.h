@@ -0,0 +1,189 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/symbolic/saturation.h
+/// \brief Saturation based computation of the states that are reachable using
+///        the learned transition relations of a sequence of summand groups.
+
+#ifndef MCRL2_SYMBOLIC_SATURATION_H
+#define MCRL2_SYMBOLIC_SATURATION_H
+
+#ifdef MCRL2_ENABLE_SYLVAN
+
+#include "mcrl2/symbolic/summand_group.h"
+
+#include <sylvan_ldd.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace mcrl2::symbolic
+{
+
+/// \brief Computes the closure of a set of states under the transition relations of a
+///        sequence of summand groups using saturation [Ciardo, Marmorstein, Siminiceanu 2003].
+/// \details The top of a summand group is the smallest level (i.e. process parameter) that
+///          it reads or writes. Saturating a node at level k means that all its children
+///          are saturated, after which the groups with top k are applied to the node until a
+///          fixpoint is reached, saturating the children of the node again whenever it changes.
+///          A saturated node is therefore closed under all groups with a top of at least k. The
+///          results are stored in an operation cache per level, which is only valid as long as
+///          the relations do not change, so it is cleared at the start of each call to run.
+class saturation_algorithm
+{
+  protected:
+    using ldd = sylvan::ldds::ldd;
+
+    struct relation
+    {
+      const summand_group* group;
+      ldd meta; // the meta data of group.Ir starting at its top level
+    };
+
+    // m_relations[k] contains the relations of the groups with top k
+    std::vector<std::vector<relation>> m_relations;
+
+    // m_cache[k] maps nodes at level k to their saturated node, the key is stored
+    // as an ldd in the value to prevent it from being garbage collected
+    std::vector<std::unordered_map<sylvan::MDD, std::pair<ldd, ldd>>> m_cache;
+
+    std::size_t m_cache_hits = 0;
+    std::size_t m_cache_misses = 0;
+
+    static std::size_t top_level(const summand_group& group)
+    {
+      std::size_t result = std::numeric_limits<std::size_t>::max();
+      if (!group.read.empty())
+      {
+        result = std::min(result, *std::min_element(group.read.begin(), group.read.end()));
+      }
+      if (!group.write.empty())
+      {
+        result = std::min(result, *std::min_element(group.write.begin(), group.write.end()));
+      }
+      return result;
+    }
+
+    void insert_cache(std::size_t level, const ldd& key, const ldd& value)
+    {
+      m_cache[level].emplace(key.get(), std::make_pair(key, value));
+    }
+
+    // Replaces every child x.down() of A by saturate(x.down(), level + 1)
+    ldd saturate_children(const ldd& A, std::size_t level)
+    {
+      using namespace sylvan::ldds;
+
+      std::vector<std::pair<std::uint32_t, ldd>> children;
+      for (ldd x = A; x != false_(); x = x.right())
+      {
+        children.emplace_back(x.value(), saturate(x.down(), level + 1));
+      }
+
+      ldd result = false_();
+      for (auto i = children.rbegin(); i != children.rend(); ++i)
+      {
+        result = node(i->first, i->second, result);
+      }
+      return result;
+    }
+
+    ldd saturate(const ldd& A, std::size_t level)
+    {
+      using namespace sylvan::ldds;
+
+      if (A == false_() || A == true_())
+      {
+        return A;
+      }
+
+      if (level >= m_cache.size())
+      {
+        m_cache.resize(level + 1);
+      }
+      auto i = m_cache[level].find(A.get());
+      if (i != m_cache[level].end())
+      {
+        m_cache_hits++;
+        return i->second.second;
+      }
+      m_cache_misses++;
+
+      ldd result = saturate_children(A, level);
+      if (level < m_relations.size() && !m_relations[level].empty())
+      {
+        ldd previous;
+        do
+        {
+          previous = result;
+          for (const relation& R: m_relations[level])
+          {
+            result = union_(result, relprod(result, R.group->L, R.meta));
+          }
+          if (result != previous)
+          {
+            result = saturate_children(result, level);
+          }
+        }
+        while (result != previous);
+      }
+
+      insert_cache(level, A, result);
+      insert_cache(level, result, result);
+      return result;
+    }
+
+  public:
+    /// \brief Constructor.
+    /// \param groups A sequence of summand groups. The relations L of the groups are not copied,
+    ///        so they may be extended with learned transitions in between calls to run.
+    template <typename SummandGroupSequence>
+    explicit saturation_algorithm(const SummandGroupSequence& groups)
+    {
+      for (const summand_group& group: groups)
+      {
+        std::size_t top = top_level(group);
+        if (top == std::numeric_limits<std::size_t>::max())
+        {
+          // The group does not change the state vector.
+          continue;
+        }
+        if (top >= m_relations.size())
+        {
+          m_relations.resize(top + 1);
+        }
+        ldd meta = group.Ir;
+        for (std::size_t k = 0; k < top; k++)
+        {
+          meta = meta.down();
+        }
+        m_relations[top].push_back(relation{&group, meta});
+      }
+    }
+
+    /// \brief Returns the smallest superset of X that is closed under the transition relations.
+    ldd run(const ldd& X)
+    {
+      m_cache.clear();
+      return saturate(X, 0);
+    }
+
+    /// \brief Returns the number of cache hits and cache misses since the construction of this object.
+    std::pair<std::size_t, std::size_t> cache_statistics() const
+    {
+      return { m_cache_hits, m_cache_misses };
+    }
+};
+
+} // namespace mcrl2::symbolic
+
+#endif // MCRL2_ENABLE_SYLVAN
+
+#endif // MCRL2_SYMBOLIC_SATURATION_H
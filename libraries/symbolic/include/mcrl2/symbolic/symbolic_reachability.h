@@ -23,6 +23,11 @@
 
 #include <sylvan_ldd.hpp>
 
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 namespace mcrl2::symbolic {
 
 struct symbolic_reachability_options
@@ -42,6 +47,7 @@ struct symbolic_reachability_options
   bool no_discard_read = false;
   bool no_discard_write = false;
   bool no_relprod = false;
+  bool parallel_learning = false;
   bool info = false;
   std::string summand_groups;
   std::string variable_order;
@@ -64,6 +70,7 @@ std::ostream& operator<<(std::ostream& out, const symbolic_reachability_options&
   out << "no-read = " << std::boolalpha << options.no_discard_read << std::endl;
   out << "no-write = " << std::boolalpha << options.no_discard_write << std::endl;
   out << "no-relprod = " << std::boolalpha << options.no_relprod << std::endl;
+  out << "parallel-learning = " << std::boolalpha << options.parallel_learning << std::endl;
   out << "info = " << std::boolalpha << options.info << std::endl;
   out << "groups = " << options.summand_groups << std::endl;
   out << "reorder = " << options.variable_order << std::endl;
@@ -107,25 +114,27 @@ void check_enumerator_solution(const EnumeratorElement& p, const summand_group&)
   }
 }
 
-/// \brief If ActionLabel is true then the multi-action will be rewritten and added to the relation.
-template <typename Context, bool ActionLabel>
-void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, void* context)
+/// \brief Computes the transitions of group that start in the projected state vector x, and calls
+///        report_transition(xy, smd) for each transition xy that is generated by the summand smd.
+/// \details If ActionLabel is true then the multi-action will be rewritten and added to the transition.
+///          The data indices of the algorithm are locked using index_mutex, unless it is a null pointer.
+template <bool ActionLabel, typename Algorithm, typename Group, typename ReportTransition>
+void learn_transitions(Algorithm& algorithm,
+                       Group& group,
+                       const data::rewriter& rewr,
+                       data::mutable_indexed_substitution<>& sigma,
+                       const data::enumerator_algorithm<>& enumerator,
+                       const std::uint32_t* x,
+                       std::mutex* index_mutex,
+                       ReportTransition report_transition)
 {
-  using namespace sylvan::ldds;
   using enumerator_element = data::enumerator_list_element_with_substitution<>;
 
-  auto p = reinterpret_cast<Context*>(context);
-  auto& algorithm = p->first;
-  auto& group = p->second;
-  auto& sigma = algorithm.m_sigma;
   auto& data_index = algorithm.data_index();
-  const auto& options = algorithm.m_options;
-  const auto& rewr = algorithm.m_rewr;
-  const auto& enumerator = algorithm.m_enumerator;
   std::size_t x_size = group.read.size();
   std::size_t y_size = group.write.size();
-  std::size_t xy_size = x_size + y_size; 
-  
+  std::size_t xy_size = x_size + y_size;
+
   if constexpr (ActionLabel)
   {
     // One additional space for the action label.
@@ -134,14 +143,23 @@ void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, v
 
   MCRL2_DECLARE_STACK_ARRAY(xy, std::uint32_t, xy_size);
 
+  std::unique_lock<std::mutex> lock;
+  if (index_mutex != nullptr)
+  {
+    lock = std::unique_lock<std::mutex>(*index_mutex, std::defer_lock);
+  }
+  auto lock_index = [&]() { if (lock.mutex() != nullptr) { lock.lock(); } };
+  auto unlock_index = [&]() { if (lock.mutex() != nullptr) { lock.unlock(); } };
+
   // add the assignments corresponding to x to sigma
   // add x to the transition xy
-  stopwatch learn_start;
+  lock_index();
   for (std::size_t j = 0; j < x_size; j++)
   {
     sigma[group.read_parameters[j]] = data_index[group.read[j]][x[j]];
     xy[group.read_pos[j]] = x[j];
   }
+  unlock_index();
 
   std::size_t i = 0;
   for (const auto& smd: group.summands)
@@ -160,17 +178,28 @@ void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, v
                                assert(value != data::undefined_data_expression());
 
                                // Determine whether this is a copy parameter, insert special value if that is the case.
-                               xy[group.write_pos[j]] = smd.copy[group.write_pos[j]] ? relprod_ignore : data_index[group.write[j]].insert(value).first;
+                               if (smd.copy[group.write_pos[j]])
+                               {
+                                 xy[group.write_pos[j]] = relprod_ignore;
+                               }
+                               else
+                               {
+                                 lock_index();
+                                 xy[group.write_pos[j]] = data_index[group.write[j]].insert(value).first;
+                                 unlock_index();
+                               }
                              }
 
                              if constexpr (ActionLabel)
                              {
                                // Action is always located on the last index of the cube.
-                               xy[xy_size - 1] = algorithm.action_index().insert(algorithm.rewrite_action(group.actions[i], rewr, sigma)).first;
+                               lps::multi_action a = algorithm.rewrite_action(group.actions[i], rewr, sigma);
+                               lock_index();
+                               xy[xy_size - 1] = algorithm.action_index().insert(a).first;
+                               unlock_index();
                              }
 
-                             mCRL2log(log::debug1) << "  " << print_transition(data_index, xy.data(), group.read, group.write) << std::endl;
-                             group.L = options.no_relprod ? union_cube(group.L, xy.data(), xy_size) : union_cube_copy(group.L, xy.data(), smd.copy.data(), xy_size);
+                             report_transition(xy.data(), smd);
                              return false;
                            },
                            data::is_false
@@ -181,6 +210,29 @@ void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, v
     data::remove_assignments(sigma, smd.variables);
   }
   data::remove_assignments(sigma, group.read_parameters);
+}
+
+/// \brief If ActionLabel is true then the multi-action will be rewritten and added to the relation.
+template <typename Context, bool ActionLabel>
+void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, void* context)
+{
+  using namespace sylvan::ldds;
+
+  auto p = reinterpret_cast<Context*>(context);
+  auto& algorithm = p->first;
+  auto& group = p->second;
+  const auto& options = algorithm.m_options;
+  std::size_t x_size = group.read.size();
+  std::size_t xy_size = x_size + group.write.size() + (ActionLabel ? 1 : 0);
+
+  stopwatch learn_start;
+  learn_transitions<ActionLabel>(algorithm, group, algorithm.m_rewr, algorithm.m_sigma, algorithm.m_enumerator, x, nullptr,
+    [&](const std::uint32_t* xy, const summand_group::summand& smd)
+    {
+      mCRL2log(log::debug1) << "  " << print_transition(algorithm.data_index(), xy, group.read, group.write) << std::endl;
+      group.L = options.no_relprod ? union_cube(group.L, xy, xy_size) : union_cube_copy(group.L, xy, smd.copy.data(), xy_size);
+    }
+  );
   group.learn_calls += 1;
   group.learn_time += learn_start.seconds();
 
@@ -190,6 +242,101 @@ void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, v
   }
 }
 
+/// \brief Learns the transitions of group for all projected state vectors in X using the given number of threads,
+///        and adds them to group.L.
+/// \details Every thread uses its own rewriter and enumerator. The learned transitions are buffered per thread,
+///          and are added to group.L by the calling thread once all threads are finished. The Lace workers are
+///          suspended in the meantime, such that the threads do not have to compete with them.
+template <bool ActionLabel, typename Algorithm, typename Group>
+void learn_successors_parallel(Algorithm& algorithm, Group& group, const sylvan::ldds::ldd& X, const data::data_specification& dataspec, std::size_t number_of_threads)
+{
+  using namespace sylvan::ldds;
+
+  const auto& options = algorithm.m_options;
+  std::size_t x_size = group.read.size();
+  std::size_t xy_size = x_size + group.write.size() + (ActionLabel ? 1 : 0);
+
+  stopwatch learn_start;
+  std::vector<std::vector<std::uint32_t>> states = ldd_solutions(X);
+  number_of_threads = std::max<std::size_t>(1, std::min(number_of_threads, states.size()));
+
+  std::mutex index_mutex;
+  std::atomic<std::size_t> next_state{0};
+
+  // For every thread the learned transitions, each preceded by the index of the summand that generated it.
+  std::vector<std::vector<std::uint32_t>> transitions(number_of_threads);
+  std::vector<std::exception_ptr> errors(number_of_threads);
+
+  lace_suspend();
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_threads);
+  for (std::size_t t = 0; t < number_of_threads; t++)
+  {
+    threads.emplace_back([&, t]()
+    {
+      try
+      {
+        data::rewriter rewr = algorithm.m_rewr.clone(); // A rewriter cannot be used by multiple threads.
+        data::mutable_indexed_substitution<> sigma;
+        data::enumerator_identifier_generator id_generator;
+        data::enumerator_algorithm<> enumerator(rewr, dataspec, rewr, id_generator, false);
+        std::vector<std::uint32_t>& buffer = transitions[t];
+
+        for (std::size_t k = next_state++; k < states.size(); k = next_state++)
+        {
+          learn_transitions<ActionLabel>(algorithm, group, rewr, sigma, enumerator, states[k].data(), &index_mutex,
+            [&](const std::uint32_t* xy, const summand_group::summand& smd)
+            {
+              buffer.push_back(static_cast<std::uint32_t>(&smd - group.summands.data()));
+              buffer.insert(buffer.end(), xy, xy + xy_size);
+            }
+          );
+        }
+      }
+      catch (...)
+      {
+        errors[t] = std::current_exception();
+        next_state = states.size();
+      }
+    });
+  }
+  for (std::thread& thread: threads)
+  {
+    thread.join();
+  }
+  lace_resume();
+
+  for (const std::exception_ptr& error: errors)
+  {
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
+  for (const std::vector<std::uint32_t>& buffer: transitions)
+  {
+    for (std::size_t k = 0; k < buffer.size(); k += xy_size + 1)
+    {
+      const summand_group::summand& smd = group.summands[buffer[k]];
+      const std::uint32_t* xy = buffer.data() + k + 1;
+      mCRL2log(log::debug1) << "  " << print_transition(algorithm.data_index(), xy, group.read, group.write) << std::endl;
+      group.L = options.no_relprod ? union_cube(group.L, xy, xy_size) : union_cube_copy(group.L, xy, smd.copy.data(), xy_size);
+    }
+  }
+
+  if (options.cached)
+  {
+    for (const std::vector<std::uint32_t>& x: states)
+    {
+      group.Ldomain = union_cube(group.Ldomain, x.data(), x_size);
+    }
+  }
+
+  group.learn_calls += states.size();
+  group.learn_time += learn_start.seconds();
+}
+
 } // namespace mcrl2::symbolic
 
 #endif // MCRL2_ENABLE_SYLVAN
@@ -0,0 +1,139 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file saturation_test.cpp
+/// \brief Compares saturation with breadth first reachability.
+
+#define BOOST_TEST_MODULE saturation_test
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(dummy_test)
+{
+  // This is an empty test since at least one test is required.
+}
+
+#ifdef MCRL2_ENABLE_SYLVAN
+
+#include "mcrl2/data/nat.h"
+#include "mcrl2/symbolic/saturation.h"
+#include "mcrl2/symbolic/test_utility.h"
+
+#include <functional>
+
+using sylvan::ldds::ldd;
+using namespace mcrl2;
+using namespace mcrl2::symbolic;
+
+// Creates a summand group that reads the parameters in read, and writes the parameters in write. For every
+// vector x of values of the read parameters with values in [0, max_value], the transition to next(x) is added.
+summand_group make_summand_group(const data::variable_list& parameters,
+                                 const std::vector<std::size_t>& read,
+                                 const std::vector<std::size_t>& write,
+                                 std::uint32_t max_value,
+                                 const std::function<std::vector<std::uint32_t>(const std::vector<std::uint32_t>&)>& next)
+{
+  boost::dynamic_bitset<> pattern(2 * parameters.size());
+  for (std::size_t j: read)
+  {
+    pattern[2 * j] = true;
+  }
+  for (std::size_t j: write)
+  {
+    pattern[2 * j + 1] = true;
+  }
+  summand_group result(parameters, pattern, false);
+
+  std::vector<std::uint32_t> x(read.size(), 0);
+  std::vector<std::uint32_t> xy(read.size() + write.size());
+  for (;;)
+  {
+    std::vector<std::uint32_t> y = next(x);
+    for (std::size_t j = 0; j < x.size(); j++)
+    {
+      xy[result.read_pos[j]] = x[j];
+    }
+    for (std::size_t j = 0; j < y.size(); j++)
+    {
+      xy[result.write_pos[j]] = y[j];
+    }
+    result.L = union_cube(result.L, xy);
+
+    // go to the next vector x
+    std::size_t j = 0;
+    while (j < x.size() && x[j] == max_value)
+    {
+      x[j++] = 0;
+    }
+    if (j == x.size())
+    {
+      break;
+    }
+    x[j]++;
+  }
+  return result;
+}
+
+ldd breadth_first_reachability(const ldd& initial_state, const std::vector<summand_group>& groups)
+{
+  ldd visited = initial_state;
+  ldd previous;
+  do
+  {
+    previous = visited;
+    for (const summand_group& group: groups)
+    {
+      visited = union_(visited, relprod(visited, group.L, group.Ir));
+    }
+  }
+  while (visited != previous);
+  return visited;
+}
+
+BOOST_AUTO_TEST_CASE(test_saturation)
+{
+  initialise_sylvan();
+
+  // The ldds must be destroyed before sylvan is stopped.
+  {
+    const std::uint32_t max_value = 3;
+    data::variable_list parameters = { data::variable("a", data::sort_nat::nat()),
+                                       data::variable("b", data::sort_nat::nat()),
+                                       data::variable("c", data::sort_nat::nat()),
+                                       data::variable("d", data::sort_nat::nat()) };
+
+    auto increment = [&](const std::vector<std::uint32_t>& x) { return std::vector<std::uint32_t>{ std::min(x[0] + 1, max_value) }; };
+    auto copy = [&](const std::vector<std::uint32_t>& x) { return std::vector<std::uint32_t>{ x[0] }; };
+    auto swap = [&](const std::vector<std::uint32_t>& x) { return std::vector<std::uint32_t>{ x[1], x[0] }; };
+
+    std::vector<summand_group> groups;
+    groups.push_back(make_summand_group(parameters, { 3 }, { 3 }, max_value, increment)); // d := d + 1
+    groups.push_back(make_summand_group(parameters, { 3 }, { 1 }, max_value, copy));      // b := d
+    groups.push_back(make_summand_group(parameters, { 1, 2 }, { 1, 2 }, max_value, swap)); // b, c := c, b
+    groups.push_back(make_summand_group(parameters, { 2 }, { 0 }, max_value, copy));      // a := c
+
+    ldd initial_state = sylvan::ldds::cube(std::vector<std::uint32_t>{ 0, 0, 0, 0 });
+
+    saturation_algorithm saturation(groups);
+    ldd expected = breadth_first_reachability(initial_state, groups);
+    ldd result = saturation.run(initial_state);
+    BOOST_CHECK(result == expected);
+
+    // Saturating a set that is already closed does not change it.
+    BOOST_CHECK(saturation.run(result) == result);
+
+    for (std::size_t i = 0; i < 10; i++)
+    {
+      ldd X = random_set(3, 4, max_value);
+      BOOST_CHECK(saturation.run(X) == breadth_first_reachability(X, groups));
+    }
+  }
+
+  quit_sylvan();
+}
+
+#endif // MCRL2_ENABLE_SYLVAN
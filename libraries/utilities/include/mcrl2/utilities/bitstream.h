@@ -10,8 +10,11 @@
 #ifndef MCRL2_UTILITIES_BITSTREAM_H
 #define MCRL2_UTILITIES_BITSTREAM_H
 
+#include "mcrl2/utilities/block_compression.h"
+
 #include <vector>
 #include <bitset>
+#include <memory>
 
 namespace mcrl2
 {
@@ -25,14 +28,19 @@ constexpr std::size_t integer_encoding_size()
   return ((sizeof(T) + 1) * 8) / 7;
 }
 
+/// \returns Whether an obitstream compresses its output when this is not specified explicitly.
+/// \details This holds iff the environment variable MCRL2_COMPRESS_STREAMS is set to a value other than 0.
+bool default_stream_compression();
+
 /// \brief A bitstream provides per bit writing of data to any stream (including stdout).
 /// \details Internally uses bitpacking and buffering for compact and efficient IO.
 class obitstream
 {
 public:
   /// \brief Provides the stream on which the write function operate.
-  obitstream(std::ostream& stream);
-  ~obitstream() { flush(); }
+  /// \param compress If true, the data is written in the block compressed format of block_compressed_ostreambuf.
+  obitstream(std::ostream& stream, bool compress = default_stream_compression());
+  ~obitstream();
 
   /// \brief Write the num_of_bits least significant bits in descending order from value.
   /// @param value Variable that contains the bits.
@@ -47,13 +55,17 @@ public:
   /// \details Uses most significant bit encoding.
   void write_integer(std::size_t value);
 
+  /// \brief Writes size bytes from the given buffer.
+  /// \details If the stream is aligned to a byte, the bytes are written directly to the underlying stream.
+  void write(const std::uint8_t* buffer, std::size_t size);
+
 private:
   /// \brief Flush the remaining bits in the buffer to the output stream.
   /// \details Note that this aligns it to the next byte, e.g. when bits_in_buffer is 6 then two zero bits are added redundantly.
   void flush();
 
-  /// \brief Writes size bytes from the given buffer.
-  void write(const std::uint8_t* buffer, std::size_t size);
+  std::unique_ptr<block_compressed_ostreambuf> m_compressed_buffer; ///< Compresses the data, if compression is enabled.
+  std::unique_ptr<std::ostream> m_compressed_stream; ///< Writes to m_compressed_buffer.
 
   std::ostream& stream;
 
@@ -71,7 +83,8 @@ class ibitstream
 {
 public:
   /// \brief Provides the stream on which the read function operate.
-  ibitstream(std::istream& stream);
+  /// \param detect_compression If true, data in the block compressed format of obitstream is detected and decompressed automatically.
+  ibitstream(std::istream& stream, bool detect_compression = true);
 
   /// \brief Reads an num_of_bits bits from the input stream and stores them in the least significant part (in descending order) of the return value.
   /// \param num_of_bits Number of bits to read from the input stream.
@@ -84,10 +97,15 @@ public:
   /// \returns A natural number that was read from the binary stream encoded in most significant bit encoding.
   std::size_t read_integer();
 
-private:
   /// \brief Read size bytes into the provided buffer.
+  /// \details If the stream is aligned to a byte, the bytes are read directly from the underlying stream.
   void read(std::size_t size, std::uint8_t* buffer);
 
+private:
+
+  std::unique_ptr<block_compressed_istreambuf> m_compressed_buffer; ///< Decompresses the data, if it is compressed.
+  std::unique_ptr<std::istream> m_compressed_stream; ///< Reads from m_compressed_buffer.
+
   std::istream& stream;
 
   /// \brief Buffer that is filled starting from bit 127 when reading.
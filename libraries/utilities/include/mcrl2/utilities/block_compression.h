@@ -0,0 +1,94 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_UTILITIES_BLOCK_COMPRESSION_H
+#define MCRL2_UTILITIES_BLOCK_COMPRESSION_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+/// \brief Compresses size bytes of the input with a byte oriented LZ77 codec and stores the result in output.
+/// \details The encoding consists of sequences of a number of literal bytes followed by a match, i.e., a
+///          length and an offset of at most 65535 bytes in the data that has been decoded before. The last
+///          sequence only contains literals. This is the same encoding as the block format of LZ4.
+void lz_compress(const std::uint8_t* input, std::size_t size, std::vector<std::uint8_t>& output);
+
+/// \brief Decompresses size bytes of input that were produced by lz_compress into exactly output_size bytes.
+/// \throws mcrl2::runtime_error if the input is not a valid encoding of output_size bytes.
+void lz_decompress(const std::uint8_t* input, std::size_t size, std::uint8_t* output, std::size_t output_size);
+
+/// \brief A stream buffer that writes the data in compressed blocks to another output stream.
+/// \details The compressed format starts with a magic sequence, of which the first byte is 0x89, and a version.
+///          Every block starts with its uncompressed size and its compressed size as variable length integers
+///          followed by the compressed data. If compression does not reduce the size then the data is stored
+///          as is, which is indicated by equal sizes. A block of size zero marks the end, such that data that is
+///          written to the output stream afterwards can be read as usual. The blocks are independent, so
+///          a reader can skip blocks without decompressing them.
+class block_compressed_ostreambuf : public std::streambuf
+{
+public:
+  /// \brief The number of (uncompressed) bytes in a block.
+  static constexpr std::size_t block_size = 1 << 20;
+
+  /// \brief Writes the header of the compressed format to the given stream.
+  block_compressed_ostreambuf(std::ostream& stream);
+
+  /// \brief Writes the remaining data and the end of the compressed format.
+  /// \details Afterwards no data can be written to this buffer.
+  void finish();
+
+protected:
+  int_type overflow(int_type ch) override;
+  int sync() override;
+
+private:
+  /// \brief Compresses the data in the put area and writes it as a block.
+  /// \throws mcrl2::runtime_error if writing to the stream failed.
+  void write_block();
+
+  std::ostream& m_stream;
+  std::vector<char> m_buffer; ///< The data of the current block.
+  std::vector<std::uint8_t> m_compressed; ///< Reserved space for the compressed data of a block.
+};
+
+/// \brief A stream buffer that reads the data written by a block_compressed_ostreambuf from another input stream.
+/// \details Reads exactly the bytes of the compressed format from the stream, so that the remainder of the
+///          stream can be read afterwards.
+class block_compressed_istreambuf : public std::streambuf
+{
+public:
+  /// \brief Reads the header of the compressed format from the given stream.
+  block_compressed_istreambuf(std::istream& stream);
+
+  /// \returns True iff the next byte of the stream is the start of the compressed format.
+  /// \details Does not consume any input.
+  static bool is_compressed(std::istream& stream);
+
+protected:
+  int_type underflow() override;
+
+private:
+  std::istream& m_stream;
+  bool m_finished = false; ///< The end of the compressed format has been read.
+  std::vector<char> m_buffer; ///< The data of the current block.
+  std::vector<std::uint8_t> m_compressed; ///< Reserved space for the compressed data of a block.
+};
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_BLOCK_COMPRESSION_H
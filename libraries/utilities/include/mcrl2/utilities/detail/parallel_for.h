@@ -0,0 +1,69 @@
+// Author(s): Jeroen Keiren
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/detail/parallel_for.h
+/// \brief Applies a function to consecutive ranges of indices using several threads.
+
+#ifndef MCRL2_UTILITIES_DETAIL_PARALLEL_FOR_H
+#define MCRL2_UTILITIES_DETAIL_PARALLEL_FOR_H
+
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace mcrl2::utilities::detail {
+
+/** \brief Applies f(begin, end) to number_of_threads consecutive ranges that together form [0, n).
+  * \details The first range is handled by the calling thread. If one of the calls throws an
+  *          exception, the first exception is rethrown after all threads have finished.
+  */
+template <typename Function>
+void parallel_for(std::size_t number_of_threads, std::size_t n, Function f)
+{
+  if (number_of_threads <= 1 || n < 2 * number_of_threads)
+  {
+    f(0, n);
+    return;
+  }
+
+  std::vector<std::exception_ptr> exceptions(number_of_threads);
+  auto run = [&](std::size_t i)
+  {
+    try
+    {
+      f(i * n / number_of_threads, (i + 1) * n / number_of_threads);
+    }
+    catch (...)
+    {
+      exceptions[i] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(run, i);
+  }
+  run(0);
+  for (std::thread& t: threads)
+  {
+    t.join();
+  }
+
+  for (const std::exception_ptr& e: exceptions)
+  {
+    if (e)
+    {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+} // namespace mcrl2::utilities::detail
+
+#endif // MCRL2_UTILITIES_DETAIL_PARALLEL_FOR_H
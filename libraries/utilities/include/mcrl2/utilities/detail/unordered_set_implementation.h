@@ -208,6 +208,8 @@ void MCRL2_UNORDERED_SET_CLASS::rehash(std::size_t number_of_buckets)
 
   // Create one bucket list for all elements in the hashtable.
   bucket_type old_keys;
+  m_split_index = 0;
+  m_split_end = 0;
   for (auto&& bucket : m_buckets)
   {
     old_keys.splice_after(old_keys.before_begin(), bucket);
@@ -232,6 +234,45 @@ void MCRL2_UNORDERED_SET_CLASS::rehash(std::size_t number_of_buckets)
   }
 }
 
+MCRL2_UNORDERED_SET_TEMPLATES
+void MCRL2_UNORDERED_SET_CLASS::start_incremental_rehash()
+{
+  // Finish the previous rehash first, such that every bucket is split at most once.
+  while (!rehash_step(m_buckets.size()));
+
+  // The new buckets are empty, so only the bucket vector itself is copied.
+  m_split_index = 0;
+  m_split_end = m_buckets.size();
+  m_buckets.resize(2 * m_buckets.size());
+  m_buckets_mask = m_buckets.size() - 1;
+
+  if constexpr (!EnableLockfreeInsertion)
+  {
+    m_bucket_mutexes = std::vector<std::mutex>(std::max(m_buckets.size() / BucketsPerMutex, 1ul));
+  }
+}
+
+MCRL2_UNORDERED_SET_TEMPLATES
+bool MCRL2_UNORDERED_SET_CLASS::rehash_step(size_type number_of_buckets)
+{
+  size_type end = std::min(m_split_end, m_split_index + number_of_buckets);
+  for (; m_split_index < end; )
+  {
+    // Mark the bucket as split first, such that find_bucket_index yields the new bucket for its elements.
+    bucket_type old_keys;
+    old_keys.splice_after(old_keys.before_begin(), m_buckets[m_split_index]);
+    ++m_split_index;
+
+    while (!old_keys.empty())
+    {
+      bucket_type& bucket = m_buckets[find_bucket_index(old_keys.front())];
+      bucket.splice_front(bucket.before_begin(), old_keys);
+    }
+  }
+
+  return !rehash_in_progress();
+}
+
 template<typename T>
 void print_performance_statistics(const T& unordered_set)
 {
@@ -349,6 +390,15 @@ std::size_t MCRL2_UNORDERED_SET_CLASS::find_bucket_index(const Args&... args) co
   /// n mod 2^i is equal to n & (2^i - 1).
   assert(m_buckets_mask == m_buckets.size() - 1);
   std::size_t index = hash & m_buckets_mask;
+  if (m_split_index != m_split_end)
+  {
+    // The elements of a bucket that has not been split yet are still stored in the lower half.
+    std::size_t lower_index = index & (m_split_end - 1);
+    if (lower_index >= m_split_index)
+    {
+      index = lower_index;
+    }
+  }
   assert(index < m_buckets.size());
   return index;
 }
@@ -0,0 +1,211 @@
+// Author(s): Wieger Wesselink, Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/detail/work_stealing_todo_set.h
+/// \brief A todo set for multi-threaded search algorithms in which every thread has
+///        its own queue of elements, and idle threads steal work from others.
+
+#ifndef MCRL2_UTILITIES_DETAIL_WORK_STEALING_TODO_SET_H
+#define MCRL2_UTILITIES_DETAIL_WORK_STEALING_TODO_SET_H
+
+#include <atomic>
+#include <cassert>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mcrl2::utilities::detail {
+
+/// \brief A set of per thread queues of elements that are still to be processed.
+/// \details Each thread inserts and removes elements in its own queue, which is
+///          only locked by the owner, unless another thread runs out of work and
+///          steals half of the elements of the queue. The owner takes elements from
+///          the front (breadth first) or the back (depth first) of its queue, while
+///          thieves take them from the other end. Termination is detected by counting
+///          the elements that are either in some queue or are being processed. The
+///          queues are indexed by the thread indices 1, ..., n.
+///          The type Deque is the type of the queues of elements, which must support
+///          the operations of a std::deque. For terms this is typically an atermpp::deque.
+template <typename Element, typename Deque = std::deque<Element>>
+class work_stealing_todo_set
+{
+  public:
+    typedef Element value_type;
+
+  protected:
+    struct thread_queue
+    {
+      std::mutex mutex;
+      Deque todo;
+      Deque stolen; // Only used by the owner to temporarily store stolen elements.
+    };
+
+    std::vector<std::unique_ptr<thread_queue>> m_queues;
+    bool m_depth_first;
+
+    // The number of elements that are stored in a queue, or that are being processed.
+    std::atomic<std::size_t> m_pending{0};
+
+    // The number of successful steals.
+    std::atomic<std::size_t> m_steal_count{0};
+
+    thread_queue& queue(std::size_t thread_index)
+    {
+      assert(1 <= thread_index && thread_index <= m_queues.size());
+      return *m_queues[thread_index - 1];
+    }
+
+    // Moves elements from the queue of the victim to the stolen buffer of the thief.
+    bool steal_from(thread_queue& victim, thread_queue& thief)
+    {
+      std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+      if (!lock.owns_lock() || victim.todo.empty())
+      {
+        return false;
+      }
+      std::size_t n = (victim.todo.size() + 1) / 2;
+      for (std::size_t k = 0; k < n; k++)
+      {
+        if (m_depth_first)
+        {
+          thief.stolen.push_back(victim.todo.front());
+          victim.todo.pop_front();
+        }
+        else
+        {
+          thief.stolen.push_back(victim.todo.back());
+          victim.todo.pop_back();
+        }
+      }
+      return true;
+    }
+
+    bool steal(std::size_t thread_index)
+    {
+      thread_queue& thief = queue(thread_index);
+      const std::size_t n = m_queues.size();
+      for (std::size_t k = 1; k < n; k++)
+      {
+        thread_queue& victim = *m_queues[(thread_index - 1 + k) % n];
+        if (steal_from(victim, thief))
+        {
+          std::lock_guard<std::mutex> guard(thief.mutex);
+          for (const value_type& x: thief.stolen)
+          {
+            thief.todo.push_back(x);
+          }
+          thief.stolen.clear();
+          m_steal_count++;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool pop(thread_queue& q, value_type& result)
+    {
+      std::lock_guard<std::mutex> guard(q.mutex);
+      if (q.todo.empty())
+      {
+        return false;
+      }
+      if (m_depth_first)
+      {
+        result = q.todo.back();
+        q.todo.pop_back();
+      }
+      else
+      {
+        result = q.todo.front();
+        q.todo.pop_front();
+      }
+      return true;
+    }
+
+  public:
+    /// \brief Constructor.
+    /// \param number_of_threads The number of threads, which are numbered from 1 to number_of_threads.
+    /// \param depth_first If true the owner of a queue processes its elements depth first, otherwise breadth first.
+    work_stealing_todo_set(std::size_t number_of_threads, bool depth_first)
+      : m_depth_first(depth_first)
+    {
+      assert(number_of_threads > 0);
+      for (std::size_t i = 0; i < number_of_threads; i++)
+      {
+        m_queues.push_back(std::make_unique<thread_queue>());
+      }
+    }
+
+    /// \brief Inserts the elements in the range [first, last) in the queue of the given thread.
+    template <typename ForwardIterator>
+    void insert(std::size_t thread_index, ForwardIterator first, ForwardIterator last)
+    {
+      thread_queue& q = queue(thread_index);
+      std::size_t n = 0;
+      {
+        std::lock_guard<std::mutex> guard(q.mutex);
+        for (; first != last; ++first)
+        {
+          q.todo.push_back(*first);
+          n++;
+        }
+      }
+      m_pending += n;
+    }
+
+    /// \brief Inserts the element x in the queue of the given thread.
+    void insert(std::size_t thread_index, const value_type& x)
+    {
+      insert(thread_index, &x, &x + 1);
+    }
+
+    /// \brief Chooses an element to be processed by the given thread. If its own queue is
+    ///        empty, elements are stolen from the queues of other threads.
+    /// \return False if no element was available, which does not mean that all work is done.
+    /// \details Every element that is successfully chosen must be finished by finish_state.
+    bool choose_element(std::size_t thread_index, value_type& result)
+    {
+      thread_queue& q = queue(thread_index);
+      if (pop(q, result))
+      {
+        return true;
+      }
+      return steal(thread_index) && pop(q, result);
+    }
+
+    /// \brief Indicates that an element obtained by choose_element has been processed, and
+    ///        that all elements that it gave rise to have been inserted.
+    void finish_state()
+    {
+      assert(m_pending > 0);
+      m_pending--;
+    }
+
+    /// \brief Returns true if there are no more elements to be processed by any thread.
+    bool empty() const
+    {
+      return m_pending == 0;
+    }
+
+    /// \brief Returns the number of elements that are in a queue or are being processed.
+    std::size_t size() const
+    {
+      return m_pending;
+    }
+
+    /// \brief Returns the number of times that a thread stole elements from another thread.
+    std::size_t steal_count() const
+    {
+      return m_steal_count;
+    }
+};
+
+} // namespace mcrl2::utilities::detail
+
+#endif // MCRL2_UTILITIES_DETAIL_WORK_STEALING_TODO_SET_H
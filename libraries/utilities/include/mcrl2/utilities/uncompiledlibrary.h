@@ -26,16 +26,16 @@
  *
  * Remarks:
  *
- * The source is compiled using a script that must take two string arguments.
- * The first argument is the source file, the second is the destination file.
- * After (successful) termination, only the source and destination files must
- * remain on disk -- it is the responsibility of the script to remove any
- * temporary files.
+ * The source is compiled using a script that takes the source files as
+ * arguments. The sources are compiled and linked into one library, and the
+ * script reports the files that it produced, the library being the last one.
+ * All reported files are removed by cleanup.
  *
  */
 
 #include <cerrno>
 #include <list>
+#include <vector>
 #include "mcrl2/utilities/dynamiclibrary.h"
 #include "mcrl2/utilities/file_utility.h"
 
@@ -53,9 +53,21 @@ class uncompiled_library : public dynamic_library
     {}
 
     void compile(const std::string& filename) 
+    {
+      compile(std::vector<std::string>(1, filename));
+    }
+
+    /// \brief Compiles the source files into one library. 
+    /// \details The compile script may compile the files concurrently. 
+    void compile(const std::vector<std::string>& filenames)
     {
       std::stringstream commandline;
-      commandline << '"' << m_compile_script << "\" " << filename << " " << " 2>&1";
+      commandline << '"' << m_compile_script << "\"";
+      for (const std::string& filename: filenames)
+      {
+        commandline << " " << filename;
+      }
+      commandline << "  2>&1";
       
       // Execute script.
       FILE* stream = popen(commandline.str().c_str(), "r");
@@ -115,6 +127,20 @@ class uncompiled_library : public dynamic_library
       m_filename = m_tempfiles.back();
     }
 
+    /// \brief Uses a library that has been compiled before, instead of compiling a source file.
+    /// \details The library is removed by cleanup, as if it was produced by the compile script.
+    void use_compiled(const std::string& filename)
+    {
+      m_tempfiles.push_back(filename);
+      m_filename = filename;
+    }
+
+    /// \brief The file name of the compiled library.
+    const std::string& library_filename() const
+    {
+      return m_filename;
+    }
+
     void leave_files()
     {
       m_tempfiles.clear();
@@ -328,6 +328,21 @@ public:
   /// \details Not standard.
   void rehash_if_needed();
 
+  /// \brief Doubles the number of buckets, but postpones moving the elements to their new bucket to rehash_step.
+  /// \details Not standard. Until the rehash is finished every lookup first determines whether the bucket
+  ///          of the element has already been split. This allows the elements to be redistributed in small
+  ///          steps, for example to bound the time that concurrent insertions must be stopped.
+  void start_incremental_rehash();
+
+  /// \brief Moves the elements of at most number_of_buckets unsplit buckets to their new bucket.
+  /// \returns True iff the incremental rehash has finished.
+  /// \details Not standard.
+  bool rehash_step(size_type number_of_buckets);
+
+  /// \returns True iff an incremental rehash has been started, but has not yet finished.
+  /// \details Not standard.
+  bool rehash_in_progress() const noexcept { return m_split_index != m_split_end; }
+
 private:
   template<typename Key_, typename T, typename Hash_, typename KeyEqual, typename Allocator_, bool ThreadSafe_>
   friend class unordered_map;
@@ -369,6 +384,11 @@ private:
   /// \brief Always equal to m_buckets.size() - 1.
   size_type m_buckets_mask;
 
+  /// \brief During an incremental rehash the buckets in [m_split_index, m_split_end) still contain the elements
+  ///        of both their own bucket and the bucket at index + m_split_end. Otherwise both are equal.
+  size_type m_split_index = 0;
+  size_type m_split_end = 0;
+
   std::vector<bucket_type> m_buckets;
   std::vector<std::mutex> m_bucket_mutexes;
 
@@ -20,6 +20,9 @@
 #include <fcntl.h>
 #endif
 
+#include <cstdlib>
+#include <cstring>
+
 using namespace mcrl2::utilities;
 
 /// \brief Encodes an unsigned variable-length integer using the most significant bit (MSB) algorithm.
@@ -98,10 +101,9 @@ static void set_stream_binary(const std::string& name, FILE* handle)
 #endif // MCRL2_PLATFORM_WINDOWS
 }
 
-obitstream::obitstream(std::ostream& stream)
-  : stream(stream)
+/// \brief Changes the given stream to binary mode if it is one of the standard streams.
+static void set_stream_binary(const std::ios& stream)
 {
-  // Ensures that the given stream is changed to binary mode.
   if (stream.rdbuf() == std::cout.rdbuf())
   {
     set_stream_binary("cout", stdout);
@@ -110,6 +112,77 @@ obitstream::obitstream(std::ostream& stream)
   {
     set_stream_binary("cerr", stderr);
   }
+  else if (stream.rdbuf() == std::cin.rdbuf())
+  {
+    set_stream_binary("cin", stdin);
+  }
+}
+
+/// \returns A stream buffer that compresses the data written to the given stream if compress is true, and nullptr otherwise.
+static std::unique_ptr<block_compressed_ostreambuf> open_compressed(std::ostream& stream, bool compress)
+{
+  // The stream must be in binary mode before the header of the compressed format is written.
+  set_stream_binary(stream);
+
+  if (compress)
+  {
+    return std::make_unique<block_compressed_ostreambuf>(stream);
+  }
+  return nullptr;
+}
+
+/// \returns A stream buffer that decompresses the given stream if it is in the block compressed format and detect is true, and nullptr otherwise.
+static std::unique_ptr<block_compressed_istreambuf> open_compressed(std::istream& stream, bool detect)
+{
+  // The stream must be in binary mode before the first byte is inspected.
+  set_stream_binary(stream);
+
+  if (detect && block_compressed_istreambuf::is_compressed(stream))
+  {
+    return std::make_unique<block_compressed_istreambuf>(stream);
+  }
+  return nullptr;
+}
+
+/// \returns A stream that uses the given stream buffer, or nullptr if there is no buffer.
+template<typename Stream, typename Buffer>
+static std::unique_ptr<Stream> make_stream(Buffer* buffer)
+{
+  if (buffer == nullptr)
+  {
+    return nullptr;
+  }
+
+  // Exceptions of the stream buffer indicate why reading or writing failed, so these are passed on.
+  std::unique_ptr<Stream> result = std::make_unique<Stream>(buffer);
+  result->exceptions(std::ios::badbit);
+  return result;
+}
+
+bool mcrl2::utilities::default_stream_compression()
+{
+  static const bool compress = []()
+  {
+    const char* value = std::getenv("MCRL2_COMPRESS_STREAMS");
+    return value != nullptr && std::strcmp(value, "0") != 0;
+  }();
+  return compress;
+}
+
+obitstream::obitstream(std::ostream& stream, bool compress)
+  : m_compressed_buffer(open_compressed(stream, compress)),
+    m_compressed_stream(make_stream<std::ostream>(m_compressed_buffer.get())),
+    stream(m_compressed_buffer ? *m_compressed_stream : stream)
+{}
+
+obitstream::~obitstream()
+{
+  flush();
+
+  if (m_compressed_buffer)
+  {
+    m_compressed_buffer->finish();
+  }
 }
 
 void obitstream::write_bits(std::size_t value, unsigned int number_of_bits)
@@ -154,15 +227,11 @@ void obitstream::write_integer(std::size_t val)
   write(integer_buffer, nr_bytes);
 }
 
-ibitstream::ibitstream(std::istream& stream)
-  : stream(stream)
-{
-  // Ensures that the given stream is changed to binary mode.
-  if (stream.rdbuf() == std::cin.rdbuf())
-  {
-    set_stream_binary("cin", stdin);
-  }
-}
+ibitstream::ibitstream(std::istream& stream, bool detect_compression)
+  : m_compressed_buffer(open_compressed(stream, detect_compression)),
+    m_compressed_stream(make_stream<std::istream>(m_compressed_buffer.get())),
+    stream(m_compressed_buffer ? *m_compressed_stream : stream)
+{}
 
 const char* ibitstream::read_string()
 {
@@ -240,6 +309,24 @@ void obitstream::flush()
 
 void obitstream::write(const uint8_t* buffer, std::size_t size)
 {
+  if (bits_in_buffer % 8 == 0 && size > 16)
+  {
+    // Write the bytes in the buffer, after which the given bytes can be written directly.
+    while (bits_in_buffer > 0)
+    {
+      stream.put(static_cast<char>((write_buffer >> 120).to_ulong()));
+      write_buffer <<= 8;
+      bits_in_buffer -= 8;
+    }
+
+    stream.write(reinterpret_cast<const char*>(buffer), size);
+    if (stream.fail())
+    {
+      throw mcrl2::runtime_error("Failed to write bytes to the output file/stream.");
+    }
+    return;
+  }
+
   for (std::size_t index = 0; index < size; ++index)
   {
     // Write a single byte for every entry in the buffer that was filled (size).
@@ -249,6 +336,29 @@ void obitstream::write(const uint8_t* buffer, std::size_t size)
 
 void ibitstream::read(std::size_t size, std::uint8_t* buffer)
 {
+  if (bits_in_buffer % 8 == 0 && size > 16)
+  {
+    // Take the bytes that are still in the buffer, and read the remaining bytes directly.
+    std::size_t index = 0;
+    while (bits_in_buffer > 0 && index < size)
+    {
+      buffer[index++] = static_cast<std::uint8_t>((read_buffer >> 120).to_ulong());
+      read_buffer <<= 8;
+      bits_in_buffer -= 8;
+    }
+
+    stream.read(reinterpret_cast<char*>(buffer + index), size - index);
+    if (stream.eof())
+    {
+      throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+    }
+    else if (stream.fail())
+    {
+      throw mcrl2::runtime_error("Failed to read bytes from the input file/stream.");
+    }
+    return;
+  }
+
   for (std::size_t index = 0; index < size; ++index)
   {
     // Read a single byte for every entry into the buffer that was filled (size).
@@ -0,0 +1,381 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/block_compression.h"
+
+#include "mcrl2/utilities/exception.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace mcrl2::utilities;
+
+/// \brief The start of the compressed format. The first byte differs from the first byte of the binary aterm and ldd formats.
+static constexpr std::uint8_t BCF_MAGIC[] = { 0x89, 'M', 'C', 'Z' };
+static constexpr std::uint8_t BCF_VERSION = 1;
+
+/// \brief Matches are at least this number of bytes.
+static constexpr std::size_t minimum_match_length = 4;
+
+/// \brief The largest offset of a match, which is stored in two bytes.
+static constexpr std::size_t maximum_offset = 65535;
+
+/// \brief The number of bits of the hash table that stores the last position of every four byte sequence.
+static constexpr std::size_t hash_bits = 16;
+
+static std::uint32_t read32(const std::uint8_t* data)
+{
+  std::uint32_t result;
+  std::memcpy(&result, data, sizeof(result));
+  return result;
+}
+
+static std::size_t hash32(std::uint32_t value)
+{
+  return (value * 2654435761u) >> (32 - hash_bits);
+}
+
+/// \brief Writes the part of a length that does not fit in the four bits of the token.
+static void write_length(std::vector<std::uint8_t>& output, std::size_t length)
+{
+  while (length >= 255)
+  {
+    output.push_back(255);
+    length -= 255;
+  }
+  output.push_back(static_cast<std::uint8_t>(length));
+}
+
+static std::size_t read_length(const std::uint8_t* input, std::size_t size, std::size_t& index)
+{
+  std::size_t length = 0;
+  std::uint8_t byte;
+  do
+  {
+    if (index >= size)
+    {
+      throw mcrl2::runtime_error("Compressed data is corrupted: a length exceeds the block.");
+    }
+    byte = input[index++];
+    length += byte;
+  }
+  while (byte == 255);
+
+  return length;
+}
+
+/// \brief Writes a sequence of the given literals followed by a match of the given length, which is omitted when the length is zero.
+static void write_sequence(std::vector<std::uint8_t>& output, const std::uint8_t* literals, std::size_t number_of_literals, std::size_t offset, std::size_t length)
+{
+  std::size_t match_length = length == 0 ? 0 : length - minimum_match_length;
+  output.push_back(static_cast<std::uint8_t>((std::min<std::size_t>(number_of_literals, 15) << 4) | std::min<std::size_t>(match_length, 15)));
+  if (number_of_literals >= 15)
+  {
+    write_length(output, number_of_literals - 15);
+  }
+  output.insert(output.end(), literals, literals + number_of_literals);
+
+  if (length != 0)
+  {
+    output.push_back(static_cast<std::uint8_t>(offset & 255));
+    output.push_back(static_cast<std::uint8_t>(offset >> 8));
+    if (match_length >= 15)
+    {
+      write_length(output, match_length - 15);
+    }
+  }
+}
+
+void mcrl2::utilities::lz_compress(const std::uint8_t* input, std::size_t size, std::vector<std::uint8_t>& output)
+{
+  output.clear();
+  std::vector<std::uint32_t> table(std::size_t(1) << hash_bits, 0);
+
+  std::size_t anchor = 0; // The first byte that has not been written.
+  std::size_t index = 0;
+  while (index + minimum_match_length <= size)
+  {
+    std::uint32_t value = read32(input + index);
+    std::uint32_t& entry = table[hash32(value)];
+    std::size_t candidate = entry;
+    entry = static_cast<std::uint32_t>(index);
+
+    if (candidate < index && index - candidate <= maximum_offset && read32(input + candidate) == value)
+    {
+      std::size_t length = minimum_match_length;
+      while (index + length < size && input[candidate + length] == input[index + length])
+      {
+        ++length;
+      }
+
+      write_sequence(output, input + anchor, index - anchor, index - candidate, length);
+      index += length;
+      anchor = index;
+    }
+    else
+    {
+      // Skip faster through data that does not compress.
+      index += 1 + ((index - anchor) >> 6);
+    }
+  }
+
+  write_sequence(output, input + anchor, size - anchor, 0, 0);
+}
+
+void mcrl2::utilities::lz_decompress(const std::uint8_t* input, std::size_t size, std::uint8_t* output, std::size_t output_size)
+{
+  std::size_t index = 0;
+  std::size_t position = 0;
+  while (true)
+  {
+    if (index >= size)
+    {
+      throw mcrl2::runtime_error("Compressed data is corrupted: unexpected end of a block.");
+    }
+    std::uint8_t token = input[index++];
+
+    std::size_t number_of_literals = token >> 4;
+    if (number_of_literals == 15)
+    {
+      number_of_literals += read_length(input, size, index);
+    }
+    if (number_of_literals > size - index || number_of_literals > output_size - position)
+    {
+      throw mcrl2::runtime_error("Compressed data is corrupted: too many literals.");
+    }
+    std::memcpy(output + position, input + index, number_of_literals);
+    index += number_of_literals;
+    position += number_of_literals;
+
+    if (index == size)
+    {
+      // The last sequence has no match.
+      break;
+    }
+
+    if (size - index < 2)
+    {
+      throw mcrl2::runtime_error("Compressed data is corrupted: unexpected end of a block.");
+    }
+    std::size_t offset = input[index] | (static_cast<std::size_t>(input[index + 1]) << 8);
+    index += 2;
+
+    std::size_t length = (token & 15) + minimum_match_length;
+    if ((token & 15) == 15)
+    {
+      length += read_length(input, size, index);
+    }
+    if (offset == 0 || offset > position || length > output_size - position)
+    {
+      throw mcrl2::runtime_error("Compressed data is corrupted: invalid match.");
+    }
+
+    if (offset >= length)
+    {
+      std::memcpy(output + position, output + position - offset, length);
+      position += length;
+    }
+    else
+    {
+      // The match overlaps with the bytes that it produces.
+      for (std::size_t end = position + length; position < end; ++position)
+      {
+        output[position] = output[position - offset];
+      }
+    }
+  }
+
+  if (position != output_size)
+  {
+    throw mcrl2::runtime_error("Compressed data is corrupted: the block has the wrong size.");
+  }
+}
+
+static void write_integer(std::ostream& stream, std::size_t value)
+{
+  while (value > 127)
+  {
+    stream.put(static_cast<char>((value & 127) | 128));
+    value >>= 7;
+  }
+  stream.put(static_cast<char>(value));
+}
+
+static std::size_t read_integer(std::istream& stream)
+{
+  std::size_t value = 0;
+  for (std::size_t shift = 0; shift < 64; shift += 7)
+  {
+    int byte = stream.get();
+    if (stream.eof())
+    {
+      throw mcrl2::runtime_error("Unexpected end-of-file reached in the compressed input file/stream.");
+    }
+    else if (stream.fail())
+    {
+      throw mcrl2::runtime_error("Failed to read bytes from the compressed input file/stream.");
+    }
+
+    value |= static_cast<std::size_t>(byte & 127) << shift;
+    if ((byte & 128) == 0)
+    {
+      return value;
+    }
+  }
+
+  throw mcrl2::runtime_error("Compressed data is corrupted: a block size is too large.");
+}
+
+block_compressed_ostreambuf::block_compressed_ostreambuf(std::ostream& stream)
+  : m_stream(stream),
+    m_buffer(block_size)
+{
+  m_stream.write(reinterpret_cast<const char*>(BCF_MAGIC), sizeof(BCF_MAGIC));
+  m_stream.put(static_cast<char>(BCF_VERSION));
+  setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+}
+
+void block_compressed_ostreambuf::finish()
+{
+  write_block();
+
+  // A block of size zero marks the end.
+  write_integer(m_stream, 0);
+  m_stream.flush();
+  if (m_stream.fail())
+  {
+    throw mcrl2::runtime_error("Failed to write bytes to the output file/stream.");
+  }
+  setp(nullptr, nullptr);
+}
+
+block_compressed_ostreambuf::int_type block_compressed_ostreambuf::overflow(int_type ch)
+{
+  if (pbase() == nullptr)
+  {
+    return traits_type::eof();
+  }
+
+  write_block();
+  if (!traits_type::eq_int_type(ch, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+  return traits_type::not_eof(ch);
+}
+
+int block_compressed_ostreambuf::sync()
+{
+  write_block();
+  m_stream.flush();
+  return m_stream.fail() ? -1 : 0;
+}
+
+void block_compressed_ostreambuf::write_block()
+{
+  std::size_t size = static_cast<std::size_t>(pptr() - pbase());
+  if (size == 0)
+  {
+    return;
+  }
+
+  const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(pbase());
+  lz_compress(data, size, m_compressed);
+
+  write_integer(m_stream, size);
+  if (m_compressed.size() < size)
+  {
+    write_integer(m_stream, m_compressed.size());
+    m_stream.write(reinterpret_cast<const char*>(m_compressed.data()), m_compressed.size());
+  }
+  else
+  {
+    // Store the data as is.
+    write_integer(m_stream, size);
+    m_stream.write(pbase(), size);
+  }
+
+  setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+  if (m_stream.fail())
+  {
+    throw mcrl2::runtime_error("Failed to write bytes to the output file/stream.");
+  }
+}
+
+block_compressed_istreambuf::block_compressed_istreambuf(std::istream& stream)
+  : m_stream(stream)
+{
+  std::uint8_t header[sizeof(BCF_MAGIC) + 1];
+  m_stream.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (m_stream.fail() || !std::equal(BCF_MAGIC, BCF_MAGIC + sizeof(BCF_MAGIC), header))
+  {
+    throw mcrl2::runtime_error("Error while reading: missing the control sequence of the compressed format.");
+  }
+
+  if (header[sizeof(BCF_MAGIC)] != BCF_VERSION)
+  {
+    throw mcrl2::runtime_error("The version (" + std::to_string(header[sizeof(BCF_MAGIC)]) + ") of the compressed input is incompatible with the version ("
+                               + std::to_string(BCF_VERSION) + ") of this tool.");
+  }
+}
+
+bool block_compressed_istreambuf::is_compressed(std::istream& stream)
+{
+  return stream.peek() == BCF_MAGIC[0];
+}
+
+block_compressed_istreambuf::int_type block_compressed_istreambuf::underflow()
+{
+  if (m_finished)
+  {
+    return traits_type::eof();
+  }
+
+  std::size_t size = read_integer(m_stream);
+  if (size == 0)
+  {
+    m_finished = true;
+    return traits_type::eof();
+  }
+
+  std::size_t compressed_size = read_integer(m_stream);
+  if (size > block_compressed_ostreambuf::block_size || compressed_size > size)
+  {
+    throw mcrl2::runtime_error("Compressed data is corrupted: invalid block size.");
+  }
+
+  m_buffer.resize(size);
+  if (compressed_size == size)
+  {
+    m_stream.read(m_buffer.data(), size);
+  }
+  else
+  {
+    m_compressed.resize(compressed_size);
+    m_stream.read(reinterpret_cast<char*>(m_compressed.data()), compressed_size);
+  }
+
+  if (m_stream.eof())
+  {
+    throw mcrl2::runtime_error("Unexpected end-of-file reached in the compressed input file/stream.");
+  }
+  else if (m_stream.fail())
+  {
+    throw mcrl2::runtime_error("Failed to read bytes from the compressed input file/stream.");
+  }
+
+  if (compressed_size != size)
+  {
+    lz_decompress(m_compressed.data(), compressed_size, reinterpret_cast<std::uint8_t*>(m_buffer.data()), size);
+  }
+
+  setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + size);
+  return traits_type::to_int_type(*gptr());
+}
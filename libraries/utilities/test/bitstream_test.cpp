@@ -43,3 +43,29 @@ BOOST_AUTO_TEST_CASE(fixed_sequence_test)
   BOOST_CHECK_EQUAL(strcmp(output.read_string(), "function_symbol"), 0);
   BOOST_CHECK_EQUAL(output.read_integer(), 5);
 }
+
+BOOST_AUTO_TEST_CASE(compressed_sequence_test)
+{
+  std::stringstream stream;
+
+  {
+    obitstream input(stream, true);
+    for (std::size_t i = 0; i < 100000; ++i)
+    {
+      input.write_integer(i % 1000);
+      input.write_bits(i % 2, 1);
+      input.write_string("function_symbol");
+    }
+  }
+
+  BOOST_CHECK_LT(stream.str().size(), 100000);
+
+  // The compressed format is detected when reading.
+  ibitstream output(stream);
+  for (std::size_t i = 0; i < 100000; ++i)
+  {
+    BOOST_CHECK_EQUAL(output.read_integer(), i % 1000);
+    BOOST_CHECK_EQUAL(output.read_bits(1), i % 2);
+    BOOST_CHECK_EQUAL(strcmp(output.read_string(), "function_symbol"), 0);
+  }
+}
@@ -0,0 +1,98 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/block_compression.h"
+#include "mcrl2/utilities/exception.h"
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+#include <random>
+#include <sstream>
+
+using namespace mcrl2::utilities;
+
+static void check_round_trip(const std::vector<std::uint8_t>& data)
+{
+  std::vector<std::uint8_t> compressed;
+  lz_compress(data.data(), data.size(), compressed);
+
+  std::vector<std::uint8_t> result(data.size());
+  lz_decompress(compressed.data(), compressed.size(), result.data(), result.size());
+  BOOST_CHECK(result == data);
+}
+
+BOOST_AUTO_TEST_CASE(lz_round_trip_test)
+{
+  std::mt19937 generator(42);
+  std::vector<std::uint8_t> random(100000);
+  for (std::uint8_t& byte: random)
+  {
+    byte = static_cast<std::uint8_t>(generator());
+  }
+
+  std::vector<std::uint8_t> repeated;
+  for (std::size_t i = 0; i < 100000; ++i)
+  {
+    repeated.push_back(static_cast<std::uint8_t>(i % 7));
+  }
+
+  check_round_trip({});
+  check_round_trip({ 1, 2, 3 });
+  check_round_trip(std::vector<std::uint8_t>(1000, 0)); // A match that overlaps with itself.
+  check_round_trip(random);
+  check_round_trip(repeated);
+
+  std::vector<std::uint8_t> compressed;
+  lz_compress(repeated.data(), repeated.size(), compressed);
+  BOOST_CHECK_LT(compressed.size(), repeated.size() / 10);
+}
+
+BOOST_AUTO_TEST_CASE(lz_corrupted_test)
+{
+  std::vector<std::uint8_t> data(1000, 5);
+  std::vector<std::uint8_t> compressed;
+  lz_compress(data.data(), data.size(), compressed);
+
+  // Decompressing into a block of the wrong size, or from truncated input, must be detected.
+  std::vector<std::uint8_t> result(data.size() + 1);
+  BOOST_CHECK_THROW(lz_decompress(compressed.data(), compressed.size(), result.data(), result.size()), mcrl2::runtime_error);
+  BOOST_CHECK_THROW(lz_decompress(compressed.data(), compressed.size() - 1, result.data(), data.size()), mcrl2::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(stream_buffer_test)
+{
+  std::stringstream stream;
+  std::string data;
+  for (std::size_t i = 0; i < 3 * block_compressed_ostreambuf::block_size / 10; ++i)
+  {
+    data += std::to_string(i % 10000) + " ";
+  }
+
+  {
+    block_compressed_ostreambuf buffer(stream);
+    std::ostream output(&buffer);
+    output << data;
+    buffer.finish();
+  }
+  BOOST_CHECK_LT(stream.str().size(), data.size());
+
+  // The data after the compressed format must be readable as usual.
+  stream << "end";
+
+  BOOST_CHECK(block_compressed_istreambuf::is_compressed(stream));
+  block_compressed_istreambuf buffer(stream);
+  std::istream input(&buffer);
+  std::string result((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+  BOOST_CHECK(result == data);
+
+  std::string end;
+  stream >> end;
+  BOOST_CHECK_EQUAL(end, "end");
+}
@@ -38,3 +38,19 @@ BOOST_AUTO_TEST_CASE(test_function_cache)
   }
 
 }
+
+BOOST_AUTO_TEST_CASE(test_fifo_cache)
+{
+  fifo_cache<int, int> cache(16);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    cache.emplace(i, i*i);
+    BOOST_CHECK(cache.size() <= 16);
+  }
+
+  // The most recently inserted element is always kept, and the first elements are evicted.
+  auto it = cache.find(99);
+  BOOST_CHECK(it != cache.end() && it->second == 99*99);
+  BOOST_CHECK_EQUAL(cache.count(0), 0);
+}
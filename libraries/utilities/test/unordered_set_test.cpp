@@ -79,6 +79,47 @@ BOOST_AUTO_TEST_CASE(test_large)
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_incremental_rehash)
+{
+  // A set that is only resized explicitly.
+  unordered_set<std::size_t, std::hash<std::size_t>, std::equal_to<std::size_t>, std::allocator<std::size_t>, false, false> test(16);
+  std::unordered_set<std::size_t> correct;
+
+  for (std::size_t i = 0; i < 10000; ++i)
+  {
+    if (!test.rehash_in_progress() && test.load_factor() >= test.max_load_factor())
+    {
+      test.start_incremental_rehash();
+    }
+
+    // Elements are inserted, found and erased while only some of the buckets have been split.
+    test.emplace(i);
+    correct.emplace(i);
+    if (i % 3 == 0)
+    {
+      test.erase(i / 2);
+      correct.erase(i / 2);
+    }
+    test.rehash_step(4);
+
+    BOOST_CHECK(test.find(i / 2) == test.end() || correct.count(i / 2) == 1);
+  }
+
+  BOOST_CHECK(test.size() == correct.size());
+  BOOST_CHECK(static_cast<std::size_t>(std::distance(test.begin(), test.end())) == correct.size());
+  for (auto& value : correct)
+  {
+    BOOST_CHECK(test.count(value) == 1);
+  }
+
+  // Finishing the rehash keeps all elements.
+  while (!test.rehash_step(4));
+  for (auto& value : correct)
+  {
+    BOOST_CHECK(test.count(value) == 1);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(test_copy)
 {
   // Test the copy constructor.
@@ -51,7 +51,7 @@ class convert_concrete_lts
 {
   public:
     convert_concrete_lts(const lps::symbolic_lts& lts, std::unique_ptr<lts::lts_builder> builder)
-      : m_lts(lts), m_builder(std::move(builder)), m_progress_monitor(mcrl2::lps::exploration_strategy::es_none)
+      : m_lts(lts), m_builder(std::move(builder)), m_discovered(lts.process_parameters.size()), m_progress_monitor(mcrl2::lps::exploration_strategy::es_none)
     {
       m_number_of_states = satcount(m_lts.states);
     }
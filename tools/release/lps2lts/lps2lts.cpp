@@ -55,6 +55,9 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       desc.add_option("no-probability-checking", "do not check if probabilities in stochastic specifications have sensible values");
       desc.add_hidden_option("dfs-recursive", "use recursive depth first search for divergence detection");
       desc.add_option("cached", "use enumeration caching techniques to speed up state space generation. ");
+      desc.add_option("cache-size", utilities::make_mandatory_argument("NUM"),
+                 "keep at most NUM entries in each enumeration cache, removing the oldest entries first; "
+                 "this option is only relevant in combination with --cached. By default the caches are unbounded. ");
       desc.add_option("todo-max", utilities::make_mandatory_argument("NUM"),
                  "keep at most NUM states in the todo list; this option is only relevant for "
                  "highway search, where NUM is the maximum number of states per level. ");
@@ -203,6 +206,14 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       options.save_at_end                           = parser.has_option("save-at-end");
       options.cached                                = parser.has_option("cached");
       options.global_cache                          = parser.has_option("global-cache");
+      if (parser.has_option("cache-size"))
+      {
+        if (!options.cached)
+        {
+          parser.error("Option 'cache-size' can only be used in combination with option 'cached'.");
+        }
+        options.cache_size = parser.option_argument_as<std::size_t>("cache-size");
+      }
       options.confluence                            = parser.has_option("confluence");
       options.one_point_rule_rewrite                = !parser.has_option("no-one-point-rule-rewrite");
       options.remove_unused_rewrite_rules           = !parser.has_option("no-remove-unused-rewrite-rules");
@@ -59,9 +59,10 @@ class lpsreach_tool: public rewriter_tool<input_output_tool>
                       "'random' variables are put in a random order\n"
                       "'a user defined permutation e.g. '1 3 2 0 4'"
                       );
+      desc.add_option("parallel-learning", "learn the transitions of a summand group using one thread per Lace worker");
       desc.add_option("max-iterations", utilities::make_optional_argument("NUM", "0"), "limit number of breadth-first iterations to NUM");
       desc.add_option("print-nodesize", "print the number of LDD nodes in addition to the number of elements represented as 'elements[nodes]'");
-      desc.add_option("saturation", "reduce the amount of breadth-first iterations required by applying the transition groups until fixed point is reached");
+      desc.add_option("saturation", "compute the reachable states using saturation, which applies the transition groups bottom-up per process parameter until a fixed point is reached");
       desc.add_hidden_option("no-discard", "do not discard any parameters");
       desc.add_hidden_option("no-read", "do not discard only-read parameters");
       desc.add_hidden_option("no-write", "do not discard only-write parameters");
@@ -88,6 +89,7 @@ class lpsreach_tool: public rewriter_tool<input_output_tool>
       options.no_discard_read                       = parser.has_option("no-read");
       options.no_discard_write                      = parser.has_option("no-write");
       options.no_relprod                            = parser.has_option("no-relprod");
+      options.parallel_learning                     = parser.has_option("parallel-learning");
       options.info                                  = parser.has_option("info");
       options.summand_groups                        = parser.option_argument("groups");
       options.variable_order                        = parser.option_argument("reorder");
@@ -101,6 +103,12 @@ class lpsreach_tool: public rewriter_tool<input_output_tool>
       {
         lace_dqsize = parser.option_argument_as<int>("lace-dqsize");
       }
+#ifndef MCRL2_THREAD_SAFE
+      if (options.parallel_learning && lace_n_workers != 1)
+      {
+        throw mcrl2::runtime_error("This tool is compiled for sequential use. The option --parallel-learning cannot be used with more than one Lace worker.");
+      }
+#endif
       if (parser.has_option("lace-stacksize"))
       {
         lace_stacksize = parser.option_argument_as<int>("lace-stacksize");
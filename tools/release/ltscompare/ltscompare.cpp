@@ -157,6 +157,10 @@ class ltscompare_tool : public ltscompare_base
         {
           return lts_compare<lts_lts_t>();
         }
+        case lts_bin:
+        {
+          return lts_compare<lts_bin_t>();
+        }
         case lts_none:
           mCRL2log(mcrl2::log::warning) << "No input format is specified. Assuming .aut format.\n";
           [[fallthrough]];
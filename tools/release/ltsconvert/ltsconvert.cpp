@@ -174,6 +174,13 @@ class ltsconvert_tool : public input_output_tool
           l_out.save(tool_options.outfilename);
           return true;
         }
+        case lts_bin:
+        {
+          lts_bin_t l_out;
+          lts_convert(l,l_out,spec.data(),spec.action_labels(),spec.process().process_parameters(),!tool_options.lpsfile.empty());
+          l_out.save(tool_options.outfilename);
+          return true;
+        }
         case lts_none:
           mCRL2log(warning) << "Cannot determine type of output. Assuming .aut.\n";
           [[fallthrough]];
@@ -217,6 +224,10 @@ class ltsconvert_tool : public input_output_tool
         {
           return load_convert_and_save<lts_lts_t>();
         }
+        case lts_bin:
+        {
+          return load_convert_and_save<lts_bin_t>();
+        }
         case lts_none:
           mCRL2log(warning) << "Cannot determine type of input. Assuming .aut.\n";
         case lts_aut:
@@ -259,10 +270,12 @@ class ltsconvert_tool : public input_output_tool
                       .add_value(lts_eq_bisim_gv)
                       .add_value(lts_eq_bisim_gjkw)
                       .add_value(lts_eq_bisim_sigref)
+                      .add_value(lts_eq_bisim_sigref_parallel)
                       .add_value(lts_eq_branching_bisim)
                       .add_value(lts_eq_branching_bisim_gv)
                       .add_value(lts_eq_branching_bisim_gjkw)
                       .add_value(lts_eq_branching_bisim_sigref)
+                      .add_value(lts_eq_branching_bisim_sigref_parallel)
                       .add_value(lts_eq_divergence_preserving_branching_bisim)
                       .add_value(lts_eq_divergence_preserving_branching_bisim_gv)
                       .add_value(lts_eq_divergence_preserving_branching_bisim_gjkw)
@@ -227,8 +227,9 @@ class ltsinfo_tool : public ltsinfo_base
       }
     }
 
-    // Print the state labels for a probabilistic lts.
-    void print_the_state_labels(const mcrl2::lts::probabilistic_lts_lts_t& l) const
+    // Print the state labels of an lts whose state labels are lists of state vectors.
+    template <class LTS>
+    void print_the_state_vectors(const LTS& l) const
     {
       if (print_state_labels)
       {
@@ -257,6 +258,18 @@ class ltsinfo_tool : public ltsinfo_base
       }
     }
 
+    // Print the state labels for a probabilistic lts.
+    void print_the_state_labels(const mcrl2::lts::probabilistic_lts_lts_t& l) const
+    {
+      print_the_state_vectors(l);
+    }
+
+    // Print the state labels for an lts in the indexed binary format.
+    void print_the_state_labels(const mcrl2::lts::lts_bin_t& l) const
+    {
+      print_the_state_vectors(l);
+    }
+
     template < class LTS_TYPE >
     bool provide_information() const
     {
@@ -321,6 +334,10 @@ class ltsinfo_tool : public ltsinfo_base
         {
           return provide_information<probabilistic_lts_lts_t>();
         }
+        case lts_bin:
+        {
+          return provide_information<lts_bin_t>();
+        }
         case lts_none:
           mCRL2log(warning) << "No input format is specified. Assuming .aut format.\n";
           [[fallthrough]];
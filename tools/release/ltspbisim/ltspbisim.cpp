@@ -204,6 +204,10 @@ class ltsconvert_tool : public input_output_tool
           mCRL2log(warning) << "Probabilistic bisimulation on a .dot file has not been implemented.";
           break;
         }
+        case lts_bin:
+        {
+          throw mcrl2::runtime_error("The indexed binary format cannot contain probabilistic transition systems.");
+        }
 
       }
    
@@ -242,6 +246,10 @@ class ltsconvert_tool : public input_output_tool
           mCRL2log(warning) << "Ltspbisim does not work on a .dot file. ";
           break;
         }
+        case lts_bin:
+        {
+          throw mcrl2::runtime_error("The indexed binary format cannot contain probabilistic transition systems.");
+        }
 
       }
       return true;
@@ -183,6 +183,10 @@ class ltspcompare_tool : public ltscompare_base
         {
           throw mcrl2::runtime_error("Reading the .dot format is not supported anymore.");
         }
+        case lts_bin:
+        {
+          throw mcrl2::runtime_error("The indexed binary format cannot contain probabilistic transition systems.");
+        }
       }
 
       return true;
@@ -170,7 +170,7 @@ class pbessolvesymbolic_tool: public rewriter_tool<input_output_tool>
       desc.add_option("info", "print read/write information of the summands");
       desc.add_option("max-iterations", utilities::make_optional_argument("NUM", "0"), "limit number of breadth-first iterations to NUM");
       desc.add_option("print-nodesize", "print the number of LDD nodes in addition to the number of elements represented as 'elements[nodes]'");
-      desc.add_option("saturation", "reduce the amount of breadth-first iterations by applying the transition groups until fixed point");
+      desc.add_option("saturation", "compute the reachable states using saturation, which applies the transition groups bottom-up per process parameter until a fixed point is reached");
       desc.add_option("solve-strategy",
                       utilities::make_enum_argument<int>("NUM")
                         .add_value_desc(0, "No on-the-fly solving is applied", true)